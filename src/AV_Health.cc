@@ -28,11 +28,11 @@
 
 using namespace std;
 
-AV_Health::AV_Health(int _av_day, Antiviral* _AV, Health* _health){
+AV_Health::AV_Health(int _av_day, Antiviral* _AV){
   AV              = _AV;
   disease          = AV->get_disease();
   av_day          = _av_day +1;
-  health          = _health;
+  next            = NULL;
   av_end_day      = -1;
   av_end_day      = av_day + AV->get_course_length();
 } 
@@ -46,7 +46,7 @@ void AV_Health::printTrace() const {
   fprintf(Global::Tracefp," %2d %2d %2d",av_day,disease,is_effective());
 }
 
-void AV_Health::update(int day){
+void AV_Health::update(int day, Health* health){
   if(day <= av_end_day){
     if(health->get_infection(0)!=NULL){
       if(Global::Debug > 3) {
@@ -37,52 +37,46 @@ public:
   AV_Health();
 
   /**
-   * Constructor that sets the AV start day, the Antiviral, and the Health of this AV_Health object
+   * Constructor that sets the AV start day and the Antiviral of this AV_Health object
    *
    * @param _av_day the av start day
    * @param _AV a pointer to the Antiviral object
-   * @param _health a pointer to the Health object
    */
-  AV_Health(int _av_day, Antiviral* _AV, Health* _health);
+  AV_Health(int _av_day, Antiviral* _AV);
   
   //Access Members 
   /**
    * @return the AV start day
    */
-  virtual int get_av_start_day()        const {return av_day;}
+  int get_av_start_day()        const {return av_day;}
 
   /**
    * @return the AV end day
    */
-  virtual int get_av_end_day()          const {return av_end_day;}
-
-  /**
-   * @return a pointer to the Health object
-   */
-  virtual Health * get_health()          const {return health;}
+  int get_av_end_day()          const {return av_end_day;}
 
   /**
    * @return the disease
    */
-  virtual int get_disease()              const {return disease;}
+  int get_disease()              const {return disease;}
 
   /**
    * @return a pointer to the AV
    */
-  virtual Antiviral * get_antiviral()    const { return AV; }
+  Antiviral * get_antiviral()    const { return AV; }
   
   /**
    * @param day the simulation day to check for
    * @return <code>true</code> if day is between the start and end days, <code>false</code> otherwise
    */
-  virtual bool is_on_av(int day) const {
+  bool is_on_av(int day) const {
     return ((day >= av_day) && (day <= av_end_day));
   }
   
   /**
    * @return <code>true</code> if av_end_day is not -1, <code>false</code> otherwise
    */
-  virtual bool is_effective() const {
+  bool is_effective() const {
     return (av_end_day !=-1);
   }
   
@@ -91,26 +85,34 @@ public:
    * Perform the daily update for this object
    *
    * @param day the simulation day
+   * @param health the Health of the agent taking the AV
    */
-  virtual void update(int day);
+  void update(int day, Health* health);
+
+  /**
+   * @return the next AV taken by the same agent, if any (see Health::take)
+   */
+  AV_Health* get_next() const {return next;}
+
+  void set_next(AV_Health* _next) {next = _next;}
 
   /**
    * Print out information about this object
    */
-  virtual void print() const;
+  void print() const;
 
   /**
    * Print out information about this object to the trace file
    */
-  virtual void printTrace() const;
+  void printTrace() const;
   
   
 private:
   int av_day;           // Day on which the AV treatment starts
   int av_end_day;       // Day on which the AV treatment ends
-  Health* health;       // Pointer to the health class for agent
   int disease;           // Disease for this AV
   Antiviral* AV;        // Pointer to the AV the person took
+  AV_Health* next;      // Next AV taken by the same agent
 };
 
 #endif
@@ -13,6 +13,10 @@
 //
 // File: Activities.cc
 //
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
 #include "Activities.h"
 #include "Behavior.h"
 #include "Classroom.h"
@@ -34,6 +38,7 @@
 #include "Person_Network_Link.h"
 #include "Place.h"
 #include "Place_List.h"
+#include "Population.h"
 #include "Random.h"
 #include "School.h"
 #include "Travel.h"
@@ -65,6 +70,10 @@ double Activities::HAZEL_seek_hc_ramp_up_mult = 1.0;
 
 Age_Map* Activities::Hospitalization_prob = NULL;
 Age_Map* Activities::Outpatient_healthcare_prob = NULL;
+bool Activities::Enable_aggregate_background_healthcare = false;
+double Activities::Background_healthcare_bound = 0.0;
+int Activities::Background_healthcare_day = -1;
+std::vector< std::vector<int> > Activities::Background_healthcare_countdown;
 
 Activities_Tracking_Data Activities::Tracking_data;
 
@@ -142,6 +151,9 @@ void Activities::initialize_static_variables() {
     Activities::Hospitalization_prob->read_from_input("hospitalization_prob");
     Activities::Outpatient_healthcare_prob = new Age_Map("Outpatient Healthcare Probability");
     Activities::Outpatient_healthcare_prob->read_from_input("outpatient_healthcare_prob");
+    int temp_int = 0;
+    Params::get_param_from_string("enable_aggregate_background_healthcare", &temp_int);
+    Activities::Enable_aggregate_background_healthcare = (temp_int == 0 ? false : true);
   }
 
   if(Global::Enable_HAZEL) {
@@ -186,6 +198,11 @@ Activities::Activities() {
   this->my_sick_leave_decision = false;
   this->home_neighborhood = NULL;
   this->profile = UNDEFINED_PROFILE;
+  this->base_weekday_schedule = 0;
+  this->base_weekend_schedule = 0;
+  this->base_schedule_profile = 0;
+  this->base_schedule_has_hospital_shift = false;
+  this->household_composition = 0;
   this->schedule_updated = -1;
   this->stored_daily_activity_locations = NULL;
   this->primary_healthcare_facility = NULL;
@@ -394,6 +411,7 @@ void Activities::assign_initial_profile() {
   if(get_household()->is_nursing_home()) {
     this->profile = NURSING_HOME_RESIDENT_PROFILE;
   }
+  update_household_composition();
 }
 
 void Activities::update(int sim_day) {
@@ -434,6 +452,10 @@ void Activities::update(int sim_day) {
   Activities::Tracking_data.daily_school_sick_days_present = 0;
   Activities::Tracking_data.daily_school_sick_days_absent = 0;
 
+  if(Global::Enable_Hospitals && Activities::Enable_aggregate_background_healthcare) {
+    Activities::prepare_background_healthcare(sim_day);
+  }
+
   // print school change activities
   if(Activities::Tracking_data.entered_school + Activities::Tracking_data.left_school > 0) {
     printf("DAY %d ENTERED_SCHOOL %d LEFT_SCHOOL %d\n",
@@ -445,6 +467,90 @@ void Activities::update(int sim_day) {
   FRED_STATUS(1, "Activities update completed\n");
 }
 
+double Activities::get_HAZEL_seek_healthcare_mult(int sim_day) {
+  //If we are within a week after the disaster
+  //Ramp up visits immediately after a disaster
+  int disaster_end = Place_List::get_HAZEL_disaster_end_sim_day();
+  if(sim_day > disaster_end && sim_day <= (disaster_end + 7)) {
+    int days_since_storm_end = sim_day - disaster_end;
+    return 1.0 + ((1.0 / static_cast<double>(days_since_storm_end)) * 0.25);
+  }
+  return 1.0;
+}
+
+int Activities::get_background_healthcare_stratum(Person* per) {
+  // agents in stratum k have probabilities at most 2^k times the background maximum
+  double max_mult = per->get_health()->get_max_chronic_condition_hospitalization_mult();
+  if(max_mult <= 1.0) {
+    return 0;
+  }
+  return static_cast<int>(ceil(log(max_mult) / log(2.0)));
+}
+
+void Activities::prepare_background_healthcare(int sim_day) {
+  // the bound for stratum 0 is the largest background probability today
+  double bound = std::max(Activities::Hospitalization_prob->get_max_value(),
+                          Activities::Outpatient_healthcare_prob->get_max_value());
+  if(Global::Enable_HAZEL) {
+    bound *= Activities::get_HAZEL_seek_healthcare_mult(sim_day) * HAZEL_MAX_INSURANCE_MULT;
+  }
+  Activities::Background_healthcare_bound = bound;
+  Activities::Background_healthcare_day = sim_day;
+
+  // the bounds may have changed, so the countdowns are drawn again
+  // (the skips are memoryless, so this does not change the distribution)
+  Activities::Background_healthcare_countdown.resize(fred::omp_get_max_threads());
+  for(int t = 0; t < static_cast<int>(Activities::Background_healthcare_countdown.size()); ++t) {
+    Activities::Background_healthcare_countdown[t].clear();
+  }
+}
+
+double Activities::get_background_healthcare_bound(int stratum) {
+  return std::min(1.0, Activities::Background_healthcare_bound * pow(2.0, stratum));
+}
+
+int Activities::draw_background_healthcare_skip(double bound) {
+  // number of agents passed over before the next candidate
+  if(bound >= 1.0) {
+    return 0;
+  }
+  double skip = floor(log(1.0 - Random::draw_random()) / log(1.0 - bound));
+  return (skip < INT_MAX / 2 ? static_cast<int>(skip) : INT_MAX / 2);
+}
+
+void Activities::consider_background_healthcare(int sim_day) {
+  // The agents whose schedule is updated form a sequence, as in the
+  // default mode.  Each agent in stratum k visits with probability
+  // p_i <= bound(k): candidates are drawn with probability bound(k) by
+  // counting down a geometric number of agents of that stratum, and each
+  // candidate is kept with probability p_i / bound(k).  The stratum is
+  // found when the schedule is updated, so it follows changes in chronic
+  // conditions, births and deaths.
+  if(sim_day != Activities::Background_healthcare_day) {
+    // a schedule updated before Activities::update
+    Activities::prepare_background_healthcare(sim_day);
+  }
+  if(Activities::Background_healthcare_bound <= 0.0) {
+    return;
+  }
+  int k = Activities::get_background_healthcare_stratum(this->myself);
+  std::vector<int> &countdown = Activities::Background_healthcare_countdown[fred::omp_get_thread_num()];
+  while(static_cast<int>(countdown.size()) <= k) {
+    int stratum = countdown.size();
+    countdown.push_back(Activities::draw_background_healthcare_skip(Activities::get_background_healthcare_bound(stratum)));
+  }
+  if(countdown[k] > 0) {
+    countdown[k]--;
+    return;
+  }
+  double bound = Activities::get_background_healthcare_bound(k);
+  countdown[k] = Activities::draw_background_healthcare_skip(bound);
+
+  // rand is uniform on [0, bound), as it is for an agent drawn one at a
+  // time whose draw falls below bound; the draws above bound are no visit
+  decide_whether_to_seek_healthcare(sim_day, Random::draw_random() * bound);
+}
+
 void Activities::update_activities_of_infectious_person(int sim_day) {
 
   FRED_VERBOSE(1,"update_activities for person %d day %d\n", this->myself->get_id(), sim_day);
@@ -558,42 +664,17 @@ void Activities::update_schedule(int sim_day) {
       }
     }
 
-    // decide whether to visit the neighborhood
-    if(this->profile == PRISONER_PROFILE || this->profile == NURSING_HOME_RESIDENT_PROFILE) {
-      // prisoners and nursing home residents stay indoors
-      this->on_schedule[Activity_index::NEIGHBORHOOD_ACTIVITY] = false;
-    } else {
-      // provisionally visit the neighborhood
-      this->on_schedule[Activity_index::NEIGHBORHOOD_ACTIVITY] = true;
+    // provisional schedule for a weekday or weekend
+    if(this->base_schedule_profile != this->profile) {
+      compute_base_schedule();
     }
-
-    // weekday vs weekend provisional activity
     if(Activities::is_weekday) {
-      if(get_school() != NULL) {	
-	this->on_schedule[Activity_index::SCHOOL_ACTIVITY] = true;     
-      }
-      if(get_classroom() != NULL) {
-        this->on_schedule[Activity_index::CLASSROOM_ACTIVITY] = true;
-      }
-      if(get_workplace() != NULL) {
-        this->on_schedule[Activity_index::WORKPLACE_ACTIVITY] = true;
-      }
-      if(get_office() != NULL) {
-        this->on_schedule[Activity_index::OFFICE_ACTIVITY] = true;
-      }
+      this->on_schedule |= std::bitset<Activity_index::DAILY_ACTIVITY_LOCATIONS>(this->base_weekday_schedule);
     } else {
-      if(this->profile == WEEKEND_WORKER_PROFILE || this->profile == STUDENT_PROFILE) {
-        if(get_workplace() != NULL) {
-          this->on_schedule[Activity_index::WORKPLACE_ACTIVITY] = true;
-        }
-        if(get_office() != NULL) {
-          this->on_schedule[Activity_index::OFFICE_ACTIVITY] = true;
-        }
-      } else if(this->is_hospital_staff()) {
+      this->on_schedule |= std::bitset<Activity_index::DAILY_ACTIVITY_LOCATIONS>(this->base_weekend_schedule);
+      if(this->base_schedule_has_hospital_shift) {
         if(Random::draw_random() < 0.4) {
-          if(get_workplace() != NULL) {
-            this->on_schedule[Activity_index::WORKPLACE_ACTIVITY] = true;
-          }
+          this->on_schedule[Activity_index::WORKPLACE_ACTIVITY] = true;
           if(get_office() != NULL) {
             this->on_schedule[Activity_index::OFFICE_ACTIVITY] = true;
           }
@@ -603,7 +684,11 @@ void Activities::update_schedule(int sim_day) {
 
     //Decide whether to visit healthcare if ASYMPTOMATIC (Background)
     if(Global::Enable_Hospitals && !this->myself->is_symptomatic() && !this->myself->is_hospitalized()) {
-      decide_whether_to_seek_healthcare(sim_day);
+      if(!Activities::Enable_aggregate_background_healthcare) {
+        decide_whether_to_seek_healthcare(sim_day);
+      } else {
+        consider_background_healthcare(sim_day);
+      }
     }
 
     //Decide whether to visit hospitalized housemates
@@ -960,132 +1045,97 @@ void Activities::decide_whether_to_stay_home(int sim_day) {
 }
 
 void Activities::decide_whether_to_seek_healthcare(int sim_day) {
+  if(Global::Enable_Hospitals && !this->is_hospitalized) {
+    decide_whether_to_seek_healthcare(sim_day, Random::draw_random());
+  }
+}
 
-  if(Global::Enable_Hospitals) {
-    bool is_a_workday = (this->on_schedule[Activity_index::WORKPLACE_ACTIVITY]
-			 || (is_teacher() && this->on_schedule[Activity_index::SCHOOL_ACTIVITY]));
-
-    if(!this->is_hospitalized) {
-
-      double rand = Random::draw_random();
-      double hospitalization_prob = Activities::Hospitalization_prob->find_value(this->myself->get_real_age()); //Background probability
-      double seek_healthcare_prob = Activities::Outpatient_healthcare_prob->find_value(this->myself->get_real_age()); //Background probability
+void Activities::get_healthcare_probs(int sim_day, double* hospitalization_prob, double* seek_healthcare_prob) {
+  *hospitalization_prob = Activities::Hospitalization_prob->find_value(this->myself->get_real_age()); //Background probability
+  *seek_healthcare_prob = Activities::Outpatient_healthcare_prob->find_value(this->myself->get_real_age()); //Background probability
 
-      //First check to see if agent will seek health care for any active symptomatic infection
-      if(this->myself->is_symptomatic()) {
-        //Get specific symptomatic diseases for multiplier
-        for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
-          if(this->myself->get_health()->is_infected(disease_id)) {
-            Disease* disease = Global::Diseases.get_disease(disease_id);
-            if(this->myself->get_health()->get_symptoms(disease_id, sim_day) > disease->get_min_symptoms_for_seek_healthcare()) {
-              hospitalization_prob += disease->get_hospitalization_prob(this->myself);
-              seek_healthcare_prob += disease->get_outpatient_healthcare_prob(this->myself);
-            }
-          }
-        }
-      }
-
-      // If the agent has chronic conditions, multiply the probability by the appropriate modifiers
-      if(Global::Enable_Chronic_Condition) {
-        if(this->myself->has_chronic_condition()) {
-          double mult = 1.0;
-          if(this->myself->is_asthmatic()) {
-            mult = Health::get_chronic_condition_hospitalization_prob_mult(this->myself->get_age(), Chronic_condition_index::ASTHMA);
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
-          if(this->myself->has_COPD()) {
-            mult = Health::get_chronic_condition_hospitalization_prob_mult(this->myself->get_age(), Chronic_condition_index::COPD);
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
-          if(this->myself->has_chronic_renal_disease()) {
-            mult = Health::get_chronic_condition_hospitalization_prob_mult(this->myself->get_age(), Chronic_condition_index::CHRONIC_RENAL_DISEASE);
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
-          if(this->myself->is_diabetic()) {
-            mult = Health::get_chronic_condition_hospitalization_prob_mult(this->myself->get_age(), Chronic_condition_index::DIABETES);
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
-          if(this->myself->has_heart_disease()) {
-            mult = Health::get_chronic_condition_hospitalization_prob_mult(this->myself->get_age(), Chronic_condition_index::HEART_DISEASE);
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
-          if(this->myself->has_hypertension()) {
-            mult = Health::get_chronic_condition_hospitalization_prob_mult(this->myself->get_age(), Chronic_condition_index::HYPERTENSION);
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
-          if(this->myself->has_hypercholestrolemia()) {
-            mult = Health::get_chronic_condition_hospitalization_prob_mult(this->myself->get_age(), Chronic_condition_index::HYPERCHOLESTROLEMIA);
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
-          if(this->myself->get_demographics()->is_pregnant()) {
-            mult = Health::get_pregnancy_hospitalization_prob_mult(this->myself->get_age());
-            hospitalization_prob *= mult;
-            seek_healthcare_prob *= mult;
-          }
+  //First check to see if agent will seek health care for any active symptomatic infection
+  if(this->myself->is_symptomatic()) {
+    //Get specific symptomatic diseases for multiplier
+    for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
+      if(this->myself->get_health()->is_infected(disease_id)) {
+        Disease* disease = Global::Diseases.get_disease(disease_id);
+        if(this->myself->get_health()->get_symptoms(disease_id, sim_day) > disease->get_min_symptoms_for_seek_healthcare()) {
+          *hospitalization_prob += disease->get_hospitalization_prob(this->myself);
+          *seek_healthcare_prob += disease->get_outpatient_healthcare_prob(this->myself);
         }
       }
+    }
+  }
 
-      if(Global::Enable_HAZEL) {
-        double mult = 1.0;
-        //If we are within a week after the disaster
-        //Ramp up visits immediately after a disaster
-        if(sim_day > Place_List::get_HAZEL_disaster_end_sim_day() && sim_day <= (Place_List::get_HAZEL_disaster_end_sim_day() + 7)) {
-          int days_since_storm_end = sim_day - Place_List::get_HAZEL_disaster_end_sim_day();
-          mult = 1.0 + ((1.0 / static_cast<double>(days_since_storm_end)) * 0.25);
-          hospitalization_prob *= mult;
-          seek_healthcare_prob *= mult;
-        }
+  // If the agent has chronic conditions, multiply the probability by the appropriate modifiers
+  if(Global::Enable_Chronic_Condition && this->myself->has_chronic_condition()) {
+    double mult = this->myself->get_health()->get_chronic_condition_hospitalization_mult();
+    *hospitalization_prob *= mult;
+    *seek_healthcare_prob *= mult;
+  }
 
-        //Multiplier by insurance type
+  if(Global::Enable_HAZEL) {
+    double mult = Activities::get_HAZEL_seek_healthcare_mult(sim_day);
+    *hospitalization_prob *= mult;
+    *seek_healthcare_prob *= mult;
+
+    //Multiplier by insurance type
+    mult = 1.0;
+    switch(this->myself->get_health()->get_insurance_type()) {
+     case Insurance_assignment_index::PRIVATE:
         mult = 1.0;
-        switch(this->myself->get_health()->get_insurance_type()) {
-         case Insurance_assignment_index::PRIVATE:
-            mult = 1.0;
-            break;
-          case Insurance_assignment_index::MEDICARE:
-            mult = 1.037;
-            break;
-          case Insurance_assignment_index::MEDICAID:
-            mult = .909;
-            break;
-          case Insurance_assignment_index::HIGHMARK:
-            mult = 1.0;
-            break;
-          case Insurance_assignment_index::UPMC:
-            mult = 1.0;
-            break;
-          case Insurance_assignment_index::UNINSURED:
-            {
-              double age = this->myself->get_real_age();
-              if(age < 5.0) { //These values are hard coded for HAZEL
-                mult = 1.0;
-              } else if(age < 18.0) {
-                mult = 0.59;
-              } else if(age < 25.0) {
-                mult = 0.33;
-              } else if(age < 45.0) {
-                mult = 0.43;
-              } else if(age < 65.0) {
-                mult = 0.5;
-              } else {
-                mult = 0.56;
-              }
-            }
-            break;
-          case Insurance_assignment_index::UNSET:
+        break;
+      case Insurance_assignment_index::MEDICARE:
+        mult = HAZEL_MAX_INSURANCE_MULT;
+        break;
+      case Insurance_assignment_index::MEDICAID:
+        mult = .909;
+        break;
+      case Insurance_assignment_index::HIGHMARK:
+        mult = 1.0;
+        break;
+      case Insurance_assignment_index::UPMC:
+        mult = 1.0;
+        break;
+      case Insurance_assignment_index::UNINSURED:
+        {
+          double age = this->myself->get_real_age();
+          if(age < 5.0) { //These values are hard coded for HAZEL
             mult = 1.0;
-            break;
+          } else if(age < 18.0) {
+            mult = 0.59;
+          } else if(age < 25.0) {
+            mult = 0.33;
+          } else if(age < 45.0) {
+            mult = 0.43;
+          } else if(age < 65.0) {
+            mult = 0.5;
+          } else {
+            mult = 0.56;
+          }
         }
-        hospitalization_prob *= mult;
-        seek_healthcare_prob *= mult;
-      }
+        break;
+      case Insurance_assignment_index::UNSET:
+        mult = 1.0;
+        break;
+    }
+    *hospitalization_prob *= mult;
+    *seek_healthcare_prob *= mult;
+  }
+}
+
+void Activities::decide_whether_to_seek_healthcare(int sim_day, double rand) {
+
+  if(Global::Enable_Hospitals) {
+    bool is_a_workday = (this->on_schedule[Activity_index::WORKPLACE_ACTIVITY]
+			 || (is_teacher() && this->on_schedule[Activity_index::SCHOOL_ACTIVITY]));
+
+    if(!this->is_hospitalized) {
+
+      double hospitalization_prob;
+      double seek_healthcare_prob;
+      get_healthcare_probs(sim_day, &hospitalization_prob, &seek_healthcare_prob);
 
       //First check to see if agent will visit a Hospital for an overnight stay, then check for an outpatient visit
       if(rand < hospitalization_prob) {
@@ -1802,14 +1852,6 @@ void Activities::start_traveling(Person* visited) {
     return;
   }
 
-  //Notify the household that someone is not going to be there
-  if(Global::Report_Childhood_Presenteeism) {
-    Household* my_hh = static_cast<Household*>(this->myself->get_household());
-    if(my_hh != NULL) {
-      my_hh->set_hh_schl_aged_chld_unemplyd_adlt_chng(true);
-    }
-  }
-
   if(visited == NULL) {
     this->is_traveling_outside = true;
   } else {
@@ -1833,12 +1875,6 @@ void Activities::stop_traveling() {
   this->is_traveling = false;
   this->is_traveling_outside = false;
   this->return_from_travel_sim_day = -1;
-  if(Global::Report_Childhood_Presenteeism) {
-    Household* my_hh = static_cast<Household*>(this->myself->get_household());
-    if(my_hh != NULL) {
-      my_hh->set_hh_schl_aged_chld_unemplyd_adlt_chng(true);
-    }
-  }
   FRED_STATUS(1, "stop traveling: id = %d\n", this->myself->get_id());
 }
 
@@ -1866,6 +1902,7 @@ bool Activities::become_a_teacher(Place* school) {
   Place* workplace = this->myself->get_workplace();
   FRED_VERBOSE(0, "leaving workplace %d %s\n", workplace->get_id(), workplace->get_label());
   change_workplace(NULL);
+  update_household_composition();
   FRED_VERBOSE(0, "become_a_teacher finished for person %d age %d\n", this->myself->get_id(),
 	      this->myself->get_age());
   // print(self);
@@ -1954,6 +1991,7 @@ void Activities::move_to_new_house(Place* house) {
   if(is_former_group_quarters_resident || house->is_group_quarters()) {
     // this will re-assign school and work activities
     this->update_profile();
+    update_household_composition();
     FRED_VERBOSE(1, "MOVE FINISHED GROUP QUARTERS: person %d profile %c oldhouse %s newhouse %s\n",
                  this->myself->get_id(), this->myself->get_profile(), get_household()->get_label(), house->get_label());
   }
@@ -2045,6 +2083,7 @@ void Activities::update_enrollee_index(Mixing_Group* mixing_group, int new_index
 ///////////////////////////////////
 
 void Activities::clear_daily_activity_locations() {
+  invalidate_base_schedule();
   for(int i = 0; i < Activity_index::DAILY_ACTIVITY_LOCATIONS; ++i) {
     if(this->link[i].is_enrolled()) {
       this->link[i].unenroll(this->myself);
@@ -2054,6 +2093,7 @@ void Activities::clear_daily_activity_locations() {
 }
   
 void Activities::enroll_in_daily_activity_location(int i) {
+  invalidate_base_schedule();
   Place* place = get_daily_activity_location(i);
   if(place != NULL) {
     this->link[i].enroll(this->myself, place);
@@ -2067,6 +2107,7 @@ void Activities::enroll_in_daily_activity_locations() {
 }
 
 void Activities::unenroll_from_daily_activity_location(int i) {
+  invalidate_base_schedule();
   Place* place = get_daily_activity_location(i);
   if(place != NULL) {
     this->link[i].unenroll(this->myself);
@@ -2113,6 +2154,7 @@ void Activities::set_daily_activity_location(int i, Place* place) {
   Place* old_place = get_daily_activity_location(i);
   FRED_VERBOSE(1, "old place %s\n", old_place? old_place->get_label():"NULL");
   if(place != old_place) {
+    invalidate_base_schedule();
     if(old_place != NULL) {
       // remove old link
       // printf("remove old link\n");
@@ -2125,6 +2167,44 @@ void Activities::set_daily_activity_location(int i, Place* place) {
   FRED_VERBOSE(1, "set daily activity location finished\n");
 }
 
+void Activities::update_household_composition() {
+  // the household this agent is enrolled in, which is not the permanent
+  // household while traveling or hospitalized
+  Household* household = static_cast<Household*>(this->link[Activity_index::HOUSEHOLD_ACTIVITY].get_place());
+  if(household != NULL) {
+    household->update_composition(this->myself);
+  }
+}
+
+void Activities::compute_base_schedule() {
+  std::bitset<Activity_index::DAILY_ACTIVITY_LOCATIONS> weekday;
+  std::bitset<Activity_index::DAILY_ACTIVITY_LOCATIONS> weekend;
+
+  // prisoners and nursing home residents stay indoors
+  if(this->profile != PRISONER_PROFILE && this->profile != NURSING_HOME_RESIDENT_PROFILE) {
+    weekday[Activity_index::NEIGHBORHOOD_ACTIVITY] = true;
+    weekend[Activity_index::NEIGHBORHOOD_ACTIVITY] = true;
+  }
+
+  weekday[Activity_index::SCHOOL_ACTIVITY] = (get_school() != NULL);
+  weekday[Activity_index::CLASSROOM_ACTIVITY] = (get_classroom() != NULL);
+  weekday[Activity_index::WORKPLACE_ACTIVITY] = (get_workplace() != NULL);
+  weekday[Activity_index::OFFICE_ACTIVITY] = (get_office() != NULL);
+
+  this->base_schedule_has_hospital_shift = false;
+  if(this->profile == WEEKEND_WORKER_PROFILE || this->profile == STUDENT_PROFILE) {
+    weekend[Activity_index::WORKPLACE_ACTIVITY] = (get_workplace() != NULL);
+    weekend[Activity_index::OFFICE_ACTIVITY] = (get_office() != NULL);
+  } else {
+    // hospital staff work some weekends; the day is drawn in update_schedule()
+    this->base_schedule_has_hospital_shift = is_hospital_staff();
+  }
+
+  this->base_weekday_schedule = (unsigned char) weekday.to_ulong();
+  this->base_weekend_schedule = (unsigned char) weekend.to_ulong();
+  this->base_schedule_profile = this->profile;
+}
+
 bool Activities::is_present(int sim_day, Place* place) {
 
   // not here if traveling abroad
@@ -2332,6 +2412,16 @@ Person* Activities::get_end_of_link(int n, Network* network) {
   return NULL;
 }
 
+Person_Network_Link* Activities::get_network_link(Network* network) {
+  int size = this->networks.size();
+  for(int i = 0; i < size; ++i) {
+    if(this->networks[i]->get_network() == network) {
+      return this->networks[i];
+    }
+  }
+  return NULL;
+}
+
 int Activities::get_index_of_sick_leave_dist(Person* per) {
   if(!Activities::Enable_default_sick_behavior) {
     if(Activities::Sick_leave_dist_method == Activities::WP_SIZE_DIST) {
@@ -73,6 +73,9 @@ class Place;
 #define PRIVATE_UNAV "Private_unav"
 #define UNINSURED_UNAV "Uninsured_unav"
 
+// largest HAZEL insurance multiplier on seeking healthcare (Medicare)
+#define HAZEL_MAX_INSURANCE_MULT 1.037
+
 namespace Activity_index {
   enum e {
     HOUSEHOLD_ACTIVITY,
@@ -161,6 +164,25 @@ public:
    */
   void decide_whether_to_seek_healthcare(int sim_day);
 
+  /**
+   * Decide whether to seek healthcare, using the given uniform draw
+   * instead of drawing a new one.
+   *
+   * @param sim_day the simulation day
+   * @param rand a draw in [0,1) that decides the visit
+   */
+  void decide_whether_to_seek_healthcare(int sim_day, double rand);
+
+  /**
+   * Compute today's probabilities of an overnight hospital stay and of an
+   * outpatient healthcare visit for this agent.
+   *
+   * @param sim_day the simulation day
+   * @param hospitalization_prob set to the probability of a hospital stay
+   * @param seek_healthcare_prob set to the probability of an outpatient visit
+   */
+  void get_healthcare_probs(int sim_day, double* hospitalization_prob, double* seek_healthcare_prob);
+
   /**
    * Have agent begin stay in a hospital
    *
@@ -441,6 +463,29 @@ public:
 
   void set_profile(char _profile) {
     this->profile = _profile;
+    update_household_composition();
+  }
+
+  /**
+   * Recount this agent in the composition of its current household (see
+   * Household::update_composition) after a change in age, profile or symptoms
+   */
+  void update_household_composition();
+
+  unsigned char get_household_composition() {
+    return this->household_composition;
+  }
+
+  void set_household_composition(unsigned char flags) {
+    this->household_composition = flags;
+  }
+
+  /**
+   * Forget the cached provisional schedule, so that it is recomputed from
+   * the current daily activity locations on the next schedule update
+   */
+  void invalidate_base_schedule() {
+    this->base_schedule_profile = 0;
   }
 
   bool is_teacher() {
@@ -539,6 +584,11 @@ public:
   
   Person* get_end_of_link(int n, Network* network);
 
+  /**
+   * @return this agent's links in the given network, or NULL if not enrolled
+   */
+  Person_Network_Link* get_network_link(Network* network);
+
 private:
 
   // pointer to owner
@@ -566,6 +616,14 @@ private:
   bool is_traveling_outside;                 // true if traveling outside modeled area
 
   char profile;                              // activities profile type
+
+  // provisional weekday and weekend schedules, computed from the profile and
+  // the daily activity locations and reused until either changes
+  unsigned char base_weekday_schedule;
+  unsigned char base_weekend_schedule;
+  char base_schedule_profile;                // profile the cache was computed for; 0 if invalid
+  bool base_schedule_has_hospital_shift;     // hospital staff who may work on a weekend
+  unsigned char household_composition;       // Household_composition flags counted by the current household
   bool is_hospitalized;
   bool is_isolated;
   int return_from_travel_sim_day;
@@ -610,6 +668,14 @@ private:
   static Age_Map* Hospitalization_prob;
   static Age_Map* Outpatient_healthcare_prob;
   static double Hospitalization_visit_housemate_prob;
+
+  // aggregate background healthcare: visitors are selected by thinning,
+  // and only the selected agents decide where to go
+  static bool Enable_aggregate_background_healthcare;
+  static double Background_healthcare_bound;
+  static int Background_healthcare_day;
+  // per thread, the agents of each stratum left to pass over
+  static std::vector< std::vector<int> > Background_healthcare_countdown;
   
   static Activities_Tracking_Data Tracking_data;
 
@@ -645,9 +711,17 @@ private:
   int get_daily_activity_location_id(int i);
   const char* get_daily_activity_location_label(int i);
   bool is_present(int sim_day, Place* place);
+  void compute_base_schedule();
 
   static int get_index_of_sick_leave_dist(Person* per);
 
+  static double get_HAZEL_seek_healthcare_mult(int sim_day);
+  static int get_background_healthcare_stratum(Person* per);
+  static void prepare_background_healthcare(int sim_day);
+  static double get_background_healthcare_bound(int stratum);
+  static int draw_background_healthcare_skip(double bound);
+  void consider_background_healthcare(int sim_day);
+
 protected:
 
   /**
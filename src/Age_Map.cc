@@ -119,6 +119,16 @@ double Age_Map::find_value(double age) {
   return 0.0;
 }
 
+double Age_Map::get_max_value() const {
+  double max_value = 0.0;
+  for(unsigned int i = 0; i < this->values.size(); i++) {
+    if(this->values[i] > max_value) {
+      max_value = this->values[i];
+    }
+  }
+  return max_value;
+}
+
 void Age_Map::print() const {
   cout << "\n" << this->name << "\n";
   for(unsigned int i = 0; i < this->ages.size(); i++) {
@@ -113,6 +113,11 @@ public:
    */
   double find_value(double age);
 
+  /**
+   * @return the largest value in the map, or 0.0 if the map is empty
+   */
+  double get_max_value() const;
+
   // Utility functions
   /**
    * Print out information about this object
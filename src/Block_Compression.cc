@@ -0,0 +1,394 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Block_Compression.cc
+//
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "Block_Compression.h"
+
+// LZ4 block format constants
+#define MIN_MATCH 4
+#define LAST_LITERALS 5
+#define MATCH_FIND_LIMIT 12
+#define MAX_DISTANCE 65535
+#define HASH_LOG 16
+
+static inline uint32_t read32(const char* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t hash32(uint32_t v) {
+  return (v * 2654435761u) >> (32 - HASH_LOG);
+}
+
+// write a length that does not fit in a token nibble
+static inline char* write_length(char* op, size_t length) {
+  while(length >= 255) {
+    *op++ = (char)255;
+    length -= 255;
+  }
+  *op++ = (char)length;
+  return op;
+}
+
+// read a length that did not fit in a token nibble
+static inline bool read_length(const char* &ip, const char* end, size_t &length) {
+  unsigned char b;
+  do {
+    if(ip >= end) {
+      return false;
+    }
+    b = (unsigned char)*ip++;
+    length += b;
+  } while(b == 255);
+  return true;
+}
+
+static char* write_sequence(char* op, const char* literals, size_t literal_length, size_t offset, size_t match_length) {
+  char* token = op++;
+  unsigned char t = 0;
+  if(literal_length >= 15) {
+    t = 15 << 4;
+    op = write_length(op, literal_length - 15);
+  } else {
+    t = literal_length << 4;
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+  if(match_length == 0) {
+    // last literals only
+    *token = (char)t;
+    return op;
+  }
+  *op++ = (char)(offset & 0xff);
+  *op++ = (char)(offset >> 8);
+  size_t ml = match_length - MIN_MATCH;
+  if(ml >= 15) {
+    t |= 15;
+    op = write_length(op, ml - 15);
+  } else {
+    t |= ml;
+  }
+  *token = (char)t;
+  return op;
+}
+
+size_t Block_Compression::max_compressed_size(size_t size) {
+  return size + size / 255 + 16;
+}
+
+size_t Block_Compression::compress(const char* src, size_t size, char* dst) {
+  char* op = dst;
+  size_t anchor = 0;
+  if(size >= MATCH_FIND_LIMIT + 1) {
+    std::vector<int64_t> table(1 << HASH_LOG, -1);
+    size_t ip = 0;
+    // matches may not start within the last MATCH_FIND_LIMIT bytes and must
+    // leave at least LAST_LITERALS bytes of literals at the end
+    size_t match_limit = size - LAST_LITERALS;
+    while(ip + MATCH_FIND_LIMIT <= size) {
+      uint32_t sequence = read32(src + ip);
+      uint32_t h = hash32(sequence);
+      int64_t ref = table[h];
+      table[h] = ip;
+      if(ref >= 0 && ip - ref <= MAX_DISTANCE && read32(src + ref) == sequence) {
+        size_t match_length = MIN_MATCH;
+        while(ip + match_length < match_limit && src[ref + match_length] == src[ip + match_length]) {
+          ++match_length;
+        }
+        op = write_sequence(op, src + anchor, ip - anchor, ip - ref, match_length);
+        ip += match_length;
+        anchor = ip;
+        // make the end of the match available for future matches
+        if(ip + MATCH_FIND_LIMIT <= size) {
+          table[hash32(read32(src + ip - 2))] = ip - 2;
+        }
+      } else {
+        ++ip;
+      }
+    }
+  }
+  op = write_sequence(op, src + anchor, size - anchor, 0, 0);
+  return op - dst;
+}
+
+bool Block_Compression::uncompress(const char* src, size_t size, char* dst, size_t uncompressed_size) {
+  const char* ip = src;
+  const char* end = src + size;
+  size_t op = 0;
+  while(ip < end) {
+    unsigned char token = (unsigned char)*ip++;
+    size_t literal_length = token >> 4;
+    if(literal_length == 15 && !read_length(ip, end, literal_length)) {
+      return false;
+    }
+    if(literal_length > (size_t)(end - ip) || literal_length > uncompressed_size - op) {
+      return false;
+    }
+    memcpy(dst + op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    if(ip == end) {
+      // last literals
+      break;
+    }
+    if(end - ip < 2) {
+      return false;
+    }
+    size_t offset = (unsigned char)ip[0] | ((size_t)(unsigned char)ip[1] << 8);
+    ip += 2;
+    if(offset == 0 || offset > op) {
+      return false;
+    }
+    size_t match_length = token & 15;
+    if(match_length == 15 && !read_length(ip, end, match_length)) {
+      return false;
+    }
+    match_length += MIN_MATCH;
+    if(match_length > uncompressed_size - op) {
+      return false;
+    }
+    // matches may overlap the bytes they produce, so copy forward one byte at a time
+    char* out = dst + op;
+    const char* match = out - offset;
+    for(size_t k = 0; k < match_length; ++k) {
+      out[k] = match[k];
+    }
+    op += match_length;
+  }
+  return op == uncompressed_size;
+}
+
+Block_Compressed_File::Block_Compressed_File() {
+  this->fd = -1;
+  this->map = NULL;
+  this->map_size = 0;
+}
+
+Block_Compressed_File::~Block_Compressed_File() {
+  close();
+}
+
+bool Block_Compressed_File::open(const char* filename) {
+  close();
+  this->fd = ::open(filename, O_RDONLY);
+  if(this->fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if(fstat(this->fd, &file_stat) != 0 || (uint64_t)file_stat.st_size < FBZ_MAGIC_LEN() + 3 * sizeof(uint64_t)) {
+    close();
+    return false;
+  }
+  this->map_size = file_stat.st_size;
+  void* m = mmap(NULL, this->map_size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+  if(m == MAP_FAILED) {
+    close();
+    return false;
+  }
+  this->map = static_cast<char*>(m);
+
+  // check magic bytes
+  if(strncmp(this->map, FBZ_MAGIC(), FBZ_MAGIC_LEN()) != 0) {
+    close();
+    return false;
+  }
+
+  // first line of the uncompressed file
+  uint64_t first_line_size;
+  memcpy(&first_line_size, this->map + FBZ_MAGIC_LEN(), sizeof(uint64_t));
+  uint64_t header_size = FBZ_MAGIC_LEN() + sizeof(uint64_t) + first_line_size;
+  if(header_size + 2 * sizeof(uint64_t) > this->map_size) {
+    close();
+    return false;
+  }
+  this->first_line.assign(this->map + FBZ_MAGIC_LEN() + sizeof(uint64_t), first_line_size);
+
+  // index is located by the trailer
+  uint64_t index_offset;
+  uint64_t number_of_blocks;
+  const char* trailer = this->map + this->map_size - 2 * sizeof(uint64_t);
+  memcpy(&index_offset, trailer, sizeof(uint64_t));
+  memcpy(&number_of_blocks, trailer + sizeof(uint64_t), sizeof(uint64_t));
+  if(index_offset < header_size
+     || index_offset + number_of_blocks * sizeof(Block_Index) + 2 * sizeof(uint64_t) != this->map_size) {
+    close();
+    return false;
+  }
+  this->blocks.resize(number_of_blocks);
+  if(number_of_blocks > 0) {
+    memcpy(&this->blocks[0], this->map + index_offset, number_of_blocks * sizeof(Block_Index));
+  }
+  for(size_t i = 0; i < this->blocks.size(); ++i) {
+    if(this->blocks[i].offset < header_size
+       || this->blocks[i].offset + this->blocks[i].compressed_size > index_offset) {
+      close();
+      return false;
+    }
+  }
+  madvise(this->map, this->map_size, MADV_WILLNEED);
+  return true;
+}
+
+void Block_Compressed_File::close() {
+  if(this->map != NULL) {
+    munmap(this->map, this->map_size);
+    this->map = NULL;
+  }
+  if(this->fd >= 0) {
+    ::close(this->fd);
+    this->fd = -1;
+  }
+  this->map_size = 0;
+  this->first_line.clear();
+  this->blocks.clear();
+}
+
+bool Block_Compressed_File::uncompress_block(int i, std::vector<char> &buffer) const {
+  const Block_Index &block = this->blocks[i];
+  buffer.resize(block.uncompressed_size);
+  if(block.uncompressed_size == 0) {
+    return true;
+  }
+  return Block_Compression::uncompress(this->map + block.offset, block.compressed_size, &buffer[0],
+      block.uncompressed_size);
+}
+
+Block_Compressed_File::Writer::Writer(FILE* out, const char* first_line, size_t first_line_size) {
+  this->out = out;
+  this->uncompressed_size = 0;
+  this->compressed_size = 0;
+  fwrite(FBZ_MAGIC(), sizeof(char), FBZ_MAGIC_LEN(), out);
+  uint64_t size = first_line_size;
+  fwrite(&size, sizeof(uint64_t), 1, out);
+  if(first_line_size > 0) {
+    fwrite(first_line, sizeof(char), first_line_size, out);
+  }
+  this->offset = FBZ_MAGIC_LEN() + sizeof(uint64_t) + first_line_size;
+}
+
+void Block_Compressed_File::Writer::write_compressed_block(const char* compressed, size_t compressed_size,
+							  size_t uncompressed_size) {
+  fwrite(compressed, sizeof(char), compressed_size, this->out);
+  Block_Index block;
+  block.offset = this->offset;
+  block.compressed_size = compressed_size;
+  block.uncompressed_size = uncompressed_size;
+  this->index.push_back(block);
+  this->offset += compressed_size;
+  this->compressed_size += compressed_size;
+  this->uncompressed_size += uncompressed_size;
+}
+
+size_t Block_Compressed_File::Writer::write_block(const char* block, size_t size) {
+  if(this->buffer.size() < Block_Compression::max_compressed_size(size)) {
+    this->buffer.resize(Block_Compression::max_compressed_size(size));
+  }
+  size_t compressed_size = Block_Compression::compress(block, size, &this->buffer[0]);
+  write_compressed_block(&this->buffer[0], compressed_size, size);
+  return compressed_size;
+}
+
+bool Block_Compressed_File::Writer::finish() {
+  uint64_t index_offset = this->offset;
+  uint64_t number_of_blocks = this->index.size();
+  if(number_of_blocks > 0) {
+    fwrite(&this->index[0], sizeof(Block_Index), number_of_blocks, this->out);
+  }
+  fwrite(&index_offset, sizeof(uint64_t), 1, this->out);
+  fwrite(&number_of_blocks, sizeof(uint64_t), 1, this->out);
+  return ferror(this->out) == 0;
+}
+
+bool Block_Compressed_File::compress_file(const char* infile_name, FILE* out, size_t block_size) {
+  int in_fd = ::open(infile_name, O_RDONLY);
+  if(in_fd < 0) {
+    fprintf(stderr, "fbz: cannot open %s\n", infile_name);
+    return false;
+  }
+  struct stat file_stat;
+  if(fstat(in_fd, &file_stat) != 0) {
+    ::close(in_fd);
+    return false;
+  }
+  uint64_t infile_size = file_stat.st_size;
+  const char* in = NULL;
+  if(infile_size > 0) {
+    void* m = mmap(NULL, infile_size, PROT_READ, MAP_PRIVATE, in_fd, 0);
+    if(m == MAP_FAILED) {
+      ::close(in_fd);
+      return false;
+    }
+    in = static_cast<const char*>(m);
+  }
+
+  // header: the first line of the file
+  const char* eol = (in == NULL ? NULL : static_cast<const char*>(memchr(in, '\n', infile_size)));
+  uint64_t first_line_size = (eol == NULL ? infile_size : eol - in + 1);
+  Writer writer(out, in, first_line_size);
+
+  // compress approximately block_size bytes at a time, ending each block on a newline
+  uint64_t begin = 0;
+  while(begin < infile_size) {
+    uint64_t end = begin + block_size;
+    if(end >= infile_size) {
+      end = infile_size;
+    } else {
+      const char* nl = static_cast<const char*>(memchr(in + end - 1, '\n', infile_size - end + 1));
+      end = (nl == NULL ? infile_size : nl - in + 1);
+    }
+    size_t input_size = end - begin;
+    size_t compressed_size = writer.write_block(in + begin, input_size);
+    fprintf(stderr, "...compressed %zu bytes down to %zu bytes\n", input_size, compressed_size);
+    begin = end;
+  }
+
+  // index and trailer
+  bool ok = writer.finish();
+  fprintf(stderr, "\nCompressed %" PRIu64 " bytes down to %" PRIu64 " bytes in %d blocks\n\n",
+      infile_size, writer.get_compressed_size(), writer.get_number_of_blocks());
+
+  if(in != NULL) {
+    munmap(const_cast<char*>(in), infile_size);
+  }
+  ::close(in_fd);
+  return ok;
+}
+
+bool Block_Compressed_File::uncompress_file(const char* infile_name, FILE* out) {
+  Block_Compressed_File file;
+  if(!file.open(infile_name)) {
+    fprintf(stderr, "fbz: %s is not a block-compressed file\n", infile_name);
+    return false;
+  }
+  std::vector<char> buffer;
+  for(int i = 0; i < file.get_number_of_blocks(); ++i) {
+    if(!file.uncompress_block(i, buffer)) {
+      fprintf(stderr, "fbz: block %d of %s is corrupt\n", i, infile_name);
+      return false;
+    }
+    if(!buffer.empty()) {
+      fwrite(&buffer[0], sizeof(char), buffer.size(), out);
+    }
+  }
+  return ferror(out) == 0;
+}
@@ -0,0 +1,188 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Block_Compression.h
+//
+// Built-in block compression for population files (no external library needed).
+// Blocks are compressed with an LZ77 codec that uses the LZ4 block format.
+//
+// File layout (".fbz"), all integers are uint64_t in host byte order:
+//
+//   [ magic ][ first_line_size ][ first line of the file ]
+//   [ compressed block 0 ][ compressed block 1 ]...
+//   [ index: (offset, compressed_size, uncompressed_size) for each block ]
+//   [ index_offset ][ number_of_blocks ]
+//
+// Every block ends on a newline, so blocks can be uncompressed and parsed
+// independently (and in parallel).  The first line of the file (normally the
+// column header) is also kept uncompressed so that readers can check the
+// file format without uncompressing anything.
+//
+#ifndef _FRED_BLOCK_COMPRESSION_H
+#define _FRED_BLOCK_COMPRESSION_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+namespace Block_Compression {
+
+  /**
+   * @param size the number of bytes to compress
+   * @return an upper bound on the compressed size of size bytes
+   */
+  size_t max_compressed_size(size_t size);
+
+  /**
+   * Compress a block of bytes
+   * @param src the bytes to compress
+   * @param size the number of bytes
+   * @param dst the output buffer, at least max_compressed_size(size) bytes
+   * @return the compressed size
+   */
+  size_t compress(const char* src, size_t size, char* dst);
+
+  /**
+   * Uncompress a block of bytes
+   * @param src the compressed bytes
+   * @param size the number of compressed bytes
+   * @param dst the output buffer
+   * @param uncompressed_size the expected uncompressed size
+   * @return true if exactly uncompressed_size bytes were produced
+   */
+  bool uncompress(const char* src, size_t size, char* dst, size_t uncompressed_size);
+}
+
+class Block_Compressed_File {
+
+  // target uncompressed size of each block; smaller blocks give more parallelism
+  static const size_t default_block_size = 1ul << 22;
+
+  static const char* FBZ_MAGIC() {
+    return "FBZ 20161019 v01";
+  }
+
+  static int FBZ_MAGIC_LEN() {
+    return std::strlen(FBZ_MAGIC());
+  }
+
+  struct Block_Index {
+    uint64_t offset;
+    uint64_t compressed_size;
+    uint64_t uncompressed_size;
+  };
+
+  int fd;
+  char* map;
+  uint64_t map_size;
+  std::string first_line;
+  std::vector<Block_Index> blocks;
+
+public:
+
+  Block_Compressed_File();
+  ~Block_Compressed_File();
+
+  /*
+   * Maps a compressed file and reads its index.  Returns false if the file
+   * does not exist or is not a block-compressed file.
+   */
+  bool open(const char* filename);
+
+  void close();
+
+  int get_number_of_blocks() const {
+    return (int)this->blocks.size();
+  }
+
+  const char* get_first_line() const {
+    return this->first_line.c_str();
+  }
+
+  uint64_t get_uncompressed_block_size(int i) const {
+    return this->blocks[i].uncompressed_size;
+  }
+
+  /*
+   * Uncompresses block i into buffer (resized to fit).  Safe to call from
+   * several threads at once.
+   */
+  bool uncompress_block(int i, std::vector<char> &buffer) const;
+
+  /*
+   * Writes a block-compressed file one block at a time, so that a file can
+   * be compressed while it is being produced.  Blocks may be compressed
+   * elsewhere (e.g. in parallel, with Block_Compression::compress) and
+   * appended in order with write_compressed_block.  Every block must end
+   * on a newline.
+   */
+  class Writer {
+  public:
+    /*
+     * Writes the header; first_line is kept uncompressed (see above) and
+     * should also be the start of the first block
+     */
+    Writer(FILE* out, const char* first_line, size_t first_line_size);
+
+    void write_compressed_block(const char* compressed, size_t compressed_size, size_t uncompressed_size);
+
+    /*
+     * Compresses and appends a block; returns the compressed size
+     */
+    size_t write_block(const char* block, size_t size);
+
+    /*
+     * Writes the index and trailer.  Returns false on a write error.
+     */
+    bool finish();
+
+    uint64_t get_uncompressed_size() const {
+      return this->uncompressed_size;
+    }
+
+    uint64_t get_compressed_size() const {
+      return this->compressed_size;
+    }
+
+    int get_number_of_blocks() const {
+      return (int)this->index.size();
+    }
+
+  private:
+    FILE* out;
+    uint64_t offset;
+    uint64_t uncompressed_size;
+    uint64_t compressed_size;
+    std::vector<Block_Index> index;
+    std::vector<char> buffer;
+  };
+
+  /*
+   * Compresses the named file to out
+   */
+  static bool compress_file(const char* infile_name, FILE* out, size_t block_size = default_block_size);
+
+  /*
+   * Uncompresses the named file to out
+   */
+  static bool uncompress_file(const char* infile_name, FILE* out);
+
+private:
+  Block_Compressed_File(const Block_Compressed_File &);
+  void operator=(const Block_Compressed_File &);
+};
+
+#endif // _FRED_BLOCK_COMPRESSION_H
@@ -53,6 +53,7 @@ County::County(int _fips) {
   this->ready_to_move.clear();
   this->households.clear();
   this->mortality_rate_adjustment_weight = 0.0;
+  this->total_mortality_rate_adjustment = 1.0;
 
   for(int i = 0; i <= Demographics::MAX_AGE; ++i) {
     this->female_popsize[i] = 0;
@@ -207,8 +208,6 @@ void County::update(int day) {
 
 void County::update_population_dynamics(int day) {
 
-  static double total_adj = 1.0;
-
   // no adjustment for first year, to avoid overreacting to low birth rate
   if(day < 1) {
     return;
@@ -224,7 +223,7 @@ void County::update_population_dynamics(int day) {
   
   double mortality_rate_adjustment = 1.0 + this->mortality_rate_adjustment_weight * error;
   
-  total_adj *= mortality_rate_adjustment;
+  this->total_mortality_rate_adjustment *= mortality_rate_adjustment;
 
   // adjust mortality rates
   for(int i = 0; i <= Demographics::MAX_AGE; ++i) {
@@ -234,7 +233,7 @@ void County::update_population_dynamics(int day) {
 
   // message to LOG file
   FRED_VERBOSE(0, "COUNTY %d POP_DYN: year %d  popsize = %d  target = %d  pct_error = %0.2f death_adj = %0.4f  total_adj = %0.4f\n",
-	             this->fips, year, this->tot_current_popsize, this->target_popsize, 100.0 * error, mortality_rate_adjustment, total_adj);
+	             this->fips, year, this->tot_current_popsize, this->target_popsize, 100.0 * error, mortality_rate_adjustment, this->total_mortality_rate_adjustment);
   
 }
 
@@ -323,6 +322,12 @@ void County::update_housing(int day) {
     this->beds = new int[houses];
     this->occupants = new int[houses];
     this->target_popsize = tot_current_popsize;
+
+    // each county draws from its own stream, so the housing moves of a
+    // county do not depend on the order in which counties are updated
+    std::mt19937_64 seed_generator((Global::Simulation_seed + Global::Simulation_run_number - 1)
+				   ^ (0x9E3779B97F4A7C15ull * (unsigned long) this->fips));
+    this->rng.set_seed(seed_generator());
   }
 
   // reserve ready_to_move vector:
@@ -395,7 +400,7 @@ void County::move_college_students_out_of_dorms(int day) {
 	      assert(person->is_college_dorm_resident());
 	      college++;
 	      // some college students leave each year
-	      if(Random::draw_random() < this->college_departure_rate) {
+	      if(this->rng.random() < this->college_departure_rate) {
           this->ready_to_move.push_back(make_pair(person,i));
 	      }
       }
@@ -458,17 +463,17 @@ void County::move_college_students_into_dorms(int day) {
   }
 
   // shuffle the applicants
-  FYShuffle< pair<Person*, int> >(this->ready_to_move);
+  FYShuffle< pair<Person*, int> >(this->ready_to_move, this->rng);
 
   // pick the top of the list to move into dorms
   for(int i = 0; i < dorm_vacancies &&this->ready_to_move.size() > 0; ++i) {
     int newhouse = dorm_rooms[i];
-    Place* houseptr = Global::Places.get_household(newhouse);
+    Place* houseptr = this->households[newhouse];
 //      printf("VACANT DORM %s ORIG %d SIZE %d\n", houseptr->get_label(),
 //      houseptr->get_orig_size(),houseptr->get_size());
     Person* person = this->ready_to_move.back().first;
     int oldhouse = this->ready_to_move.back().second;
-    Place* ohouseptr = Global::Places.get_household(oldhouse);
+    Place* ohouseptr = this->households[oldhouse];
     this->ready_to_move.pop_back();
     // move person to new home
 //      printf("APPLICANT %d SEX %c AGE %d HOUSE %s SIZE %d ORIG %d PROFILE %c\n",
@@ -497,7 +502,7 @@ void County::move_military_personnel_out_of_barracks(int day) {
 	      assert(person->is_military_base_resident());
 	      military++;
 	      // some military leave each each year
-	      if(Random::draw_random() < this->military_departure_rate) {
+	      if(this->rng.random() < this->military_departure_rate) {
 	        this->ready_to_move.push_back(make_pair(person,i));
 	      }
       }
@@ -557,17 +562,17 @@ void County::move_military_personnel_into_barracks(int day) {
   }
 
   // shuffle the recruits
-  FYShuffle< pair<Person*, int> >(this->ready_to_move);
+  FYShuffle< pair<Person*, int> >(this->ready_to_move, this->rng);
 
   // pick the top of the list to move into dorms
   for(int i = 0; i < barracks_vacancies && ready_to_move.size() > 0; ++i) {
     int newhouse = barracks_units[i];
-    Place* houseptr = Global::Places.get_household(newhouse);
+    Place* houseptr = this->households[newhouse];
     // printf("UNFILLED BARRACKS %s ORIG %d SIZE %d\n", houseptr->get_label(),
     // houseptr->get_orig_size(),houseptr->get_size());
     Person* person = this->ready_to_move.back().first;
     int oldhouse = this->ready_to_move.back().second;
-    Place* ohouseptr = Global::Places.get_household(oldhouse);
+    Place* ohouseptr = this->households[oldhouse];
     this->ready_to_move.pop_back();
     // move person to new home
     // printf("RECRUIT %d SEX %c AGE %d HOUSE %s SIZE %d ORIG %d PROFILE %c\n",
@@ -596,7 +601,7 @@ void County::move_inmates_out_of_prisons(int day) {
 	      assert(person->is_prisoner());
 	      prisoners++;
 	      // some prisoners get out each year
-	      if(Random::draw_random() < this->prison_departure_rate) {
+	      if(this->rng.random() < this->prison_departure_rate) {
 	        this->ready_to_move.push_back(make_pair(person,i));
 	      }
       }
@@ -656,17 +661,17 @@ void County::move_inmates_into_prisons(int day) {
   }
 
   // shuffle the inmates
-  FYShuffle< pair<Person*, int> >(this->ready_to_move);
+  FYShuffle< pair<Person*, int> >(this->ready_to_move, this->rng);
 
   // pick the top of the list to move into dorms
   for(int i = 0; i < jail_cell_vacancies && this->ready_to_move.size() > 0; ++i) {
     int newhouse = jail_cell_units[i];
-    Place* houseptr = Global::Places.get_household(newhouse);
+    Place* houseptr = this->households[newhouse];
     // printf("UNFILLED JAIL_CELL %s ORIG %d SIZE %d\n", houseptr->get_label(),
     // houseptr->get_orig_size(),houseptr->get_size());
     Person* person = this->ready_to_move.back().first;
     int oldhouse = this->ready_to_move.back().second;
-    Place* ohouseptr = Global::Places.get_household(oldhouse);
+    Place* ohouseptr = this->households[oldhouse];
     this->ready_to_move.pop_back();
     // move person to new home
     // printf("INMATE %d SEX %c AGE %d HOUSE %s SIZE %d ORIG %d PROFILE %c\n",
@@ -726,16 +731,16 @@ void County::move_patients_into_nursing_homes(int day) {
   // printf("NURSING HOME POSSIBLE PATIENTS %d\n", (int)ready_to_move.size());
 
   // shuffle the patients
-  FYShuffle< pair<Person*, int> >(this->ready_to_move);
+  FYShuffle< pair<Person*, int> >(this->ready_to_move, this->rng);
 
   // pick the top of the list to move into nursing_home
   for(int i = 0; i < nursing_home_vacancies && this->ready_to_move.size() > 0; ++i) {
     int newhouse = nursing_home_units[i];
-    Place* houseptr = Global::Places.get_household(newhouse);
+    Place* houseptr = this->households[newhouse];
     // printf("UNFILLED NURSING_HOME UNIT %s ORIG %d SIZE %d\n", houseptr->get_label(),houseptr->get_orig_size(),houseptr->get_size());
     Person* person = this->ready_to_move.back().first;
     int oldhouse = this->ready_to_move.back().second;
-    Place* ohouseptr = Global::Places.get_household(oldhouse);
+    Place* ohouseptr = this->households[oldhouse];
     this->ready_to_move.pop_back();
     // move person to new home
     /*
@@ -764,7 +769,7 @@ void County::move_young_adults(int day) {
 	      Person* person = house->get_enrollee(j);
 	      int age = person->get_age();
 	      if(18 <= age && age < 30) {
-	        if(Random::draw_random() < this->youth_home_departure_rate) {
+	        if(this->rng.random() < this->youth_home_departure_rate) {
 	          this->ready_to_move.push_back(make_pair(person,i));
 	        }
 	      }
@@ -802,7 +807,7 @@ void County::move_older_adults(int day) {
       }
       if(adults > 1) {
 	      Person* person = house->get_enrollee(pos);
-	      if(Random::draw_random() < this->adult_home_departure_rate) {
+	      if(this->rng.random() < this->adult_home_departure_rate) {
 	        this->ready_to_move.push_back(make_pair(person,i));
 	      }
       }
@@ -838,7 +843,7 @@ void County::swap_houses(int day) {
   }
   for(int i = 0; i < this->houses; ++i) {
     // skip group quarters
-    if(Global::Places.get_household(i)->is_group_quarters()) {
+    if(this->households[i]->is_group_quarters()) {
       continue;
     }
     int b = this->beds[i];
@@ -864,7 +869,7 @@ void County::swap_houses(int day) {
 	      houselist[j][i].pop_back();
 	      // swap houses hi and hj
 	      // printf("SWAPPING: "); report_ages(day,hi); report_ages(day,hj); printf("\n");
-	      Global::Places.swap_houses(hi, hj);
+	      Global::Places.swap_houses(this->households[hi], this->households[hj]);
 	      this->occupants[hi] = i;
 	      this->occupants[hj] = j;
 	      // printf("AFTER:\n"); report_ages(day,hi); report_ages(day,hj);
@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "Demographics.h"
+#include "Random.h"
 
 class Person;
 class Household;
@@ -124,7 +125,6 @@ public:
   void move_older_adults(int day);
   void report_ages(int day, int house_id);
   void swap_houses(int day);
-  int find_fips_code(int n);
   int get_housing_data(int* target_size, int* current_size);
   void report_household_distributions();
   void report_county_population();
@@ -160,6 +160,7 @@ private:
   double male_mortality_rate[Demographics::MAX_AGE + 1];
   double female_mortality_rate[Demographics::MAX_AGE + 1];
   double mortality_rate_adjustment_weight;
+  double total_mortality_rate_adjustment;
   double adjusted_male_mortality_rate[Demographics::MAX_AGE + 1];
   double adjusted_female_mortality_rate[Demographics::MAX_AGE + 1];
   double birth_rate[Demographics::MAX_AGE + 1];
@@ -178,6 +179,9 @@ private:
   int max_occupants;
   std::vector< pair<Person*, int> > ready_to_move;
 
+  // random stream for the housing moves in this county
+  RNG rng;
+
   // pointers to households
   std::vector<Household*> households;
   int houses;
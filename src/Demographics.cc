@@ -41,9 +41,7 @@ int Demographics::deaths_ytd = 0;
 int Demographics::total_deaths = 0;
 
 std::vector<Person*> Demographics::birthday_vecs[367]; //0 won't be used | day 1 - 366
-std::map<Person*, int> Demographics::birthday_map;
 
-std::vector<int> Demographics::fips_codes;
 
 Events* Demographics::conception_queue = new Events;
 Events* Demographics::maternity_queue = new Events;
@@ -52,7 +50,6 @@ Events* Demographics::mortality_queue = new Events;
 
 void Demographics::initialize_static_variables() {
   // clear birthday lists
-  Demographics::birthday_map.clear();
   for(int i = 0; i < 367; ++i) {
     Demographics::birthday_vecs[i].reserve(100);
     Demographics::birthday_vecs[i].clear();
@@ -68,6 +65,7 @@ Demographics::Demographics() {
   this->deceased_sim_day = -1;
   this->conception_sim_day = -1;
   this->maternity_sim_day = -1;
+  this->birthday_list_index = -1;
   this->pregnant = false;
   this->deceased = false;
   this->relationship = -1;
@@ -95,6 +93,7 @@ void Demographics::setup(Person* self, short int _age, char _sex,
   this->deceased_sim_day = -1;
   this->conception_sim_day = -1;
   this->maternity_sim_day = -1;
+  this->birthday_list_index = -1;
   this->pregnant = false;
   this->deceased = false;
   this->number_of_children = 0;
@@ -276,25 +275,19 @@ void Demographics::update_birth_stats(int day, Person* self) {
 }
 
 
-void Demographics::birthday(Person* self, int day ) {
+int Demographics::draw_birthday_events(Person* self, int day) {
 
   if(!Global::Enable_Population_Dynamics) {
-    return;
+    return 0;
   }
 
-  FRED_STATUS(2, "Birthday entered for person %d with (previous) age %d\n", self->get_id(), self->get_age());
-
+  int events = 0;
+  int new_age = this->age + 1;
   int county_index = self->get_household()->get_county_index();
-  //The count of agents at the current age is decreased by 1
-  Global::Places.decrement_population_of_county_with_index(county_index, self);
-  // change age
-  this->age++;
-  //The count of agents at the new age is increased by 1
-  Global::Places.increment_population_of_county_with_index(county_index, self);
 
   // will this person die in the next year?
   double age_specific_probability_of_death = 0.0;
-  if(Demographics::MAX_AGE <= this->age) {
+  if(Demographics::MAX_AGE <= new_age) {
     age_specific_probability_of_death = 1.0;
     // printf("DAY %d DEATH BY MAX_AGE RULE\n", day);
     /*
@@ -304,24 +297,21 @@ void Demographics::birthday(Person* self, int day ) {
     */
   } else {
     // look up mortality in the mortality rate tables
-    age_specific_probability_of_death = Global::Places.get_county_with_index(county_index)->get_mortality_rate(this->age, this->sex);
+    age_specific_probability_of_death = Global::Places.get_county_with_index(county_index)->get_mortality_rate(new_age, this->sex);
   }
   if(this->deceased == false && this->deceased_sim_day == -1 &&
        Random::draw_random() <= age_specific_probability_of_death) {
     
     // Yes, so set the death day (in simulation days)
     this->deceased_sim_day = (day + Random::draw_random_int(0,364));
-    Demographics::add_mortality_event(deceased_sim_day, self);
-    FRED_STATUS(1, "MORTALITY EVENT ADDDED today %d id %d age %d decease %d\n", day, self->get_id(), age, deceased_sim_day);
-  } else {
-    FRED_STATUS(2, "SURVIVER: AGE %d deceased_sim_day = %d\n", age, this->deceased_sim_day);
+    events |= BIRTHDAY_MORTALITY;
   }
   
   // Will this person conceive in the coming year year?
-  double pregnancy_rate = Global::Places.get_county_with_index(county_index)->get_pregnancy_rate(this->age);
+  double pregnancy_rate = Global::Places.get_county_with_index(county_index)->get_pregnancy_rate(new_age);
   if(this->sex == 'F' &&
-     Demographics::MIN_PREGNANCY_AGE <= this->age &&
-     this->age <= Demographics::MAX_PREGNANCY_AGE &&
+     Demographics::MIN_PREGNANCY_AGE <= new_age &&
+     new_age <= Demographics::MAX_PREGNANCY_AGE &&
      this->conception_sim_day == -1 && this->maternity_sim_day == -1 &&
      self->lives_in_group_quarters() == false &&
      Random::draw_random() < pregnancy_rate) {
@@ -330,6 +320,35 @@ void Demographics::birthday(Person* self, int day ) {
     
     // ignore small distortion due to leap years
     this->conception_sim_day = day + Random::draw_random_int(1, 365);
+    events |= BIRTHDAY_CONCEPTION;
+  }
+  return events;
+}
+
+void Demographics::birthday(Person* self, int day, int events) {
+
+  if(!Global::Enable_Population_Dynamics) {
+    return;
+  }
+
+  FRED_STATUS(2, "Birthday entered for person %d with (previous) age %d\n", self->get_id(), self->get_age());
+
+  int county_index = self->get_household()->get_county_index();
+  //The count of agents at the current age is decreased by 1
+  Global::Places.decrement_population_of_county_with_index(county_index, self);
+  // change age
+  this->age++;
+  //The count of agents at the new age is increased by 1
+  Global::Places.increment_population_of_county_with_index(county_index, self);
+
+  if(events & BIRTHDAY_MORTALITY) {
+    Demographics::add_mortality_event(this->deceased_sim_day, self);
+    FRED_STATUS(1, "MORTALITY EVENT ADDDED today %d id %d age %d decease %d\n", day, self->get_id(), age, deceased_sim_day);
+  } else {
+    FRED_STATUS(2, "SURVIVER: AGE %d deceased_sim_day = %d\n", age, this->deceased_sim_day);
+  }
+  
+  if(events & BIRTHDAY_CONCEPTION) {
     Demographics::add_conception_event(this->conception_sim_day, self);
     FRED_STATUS(1, "CONCEPTION EVENT ADDDED today %d id %d age %d conceive %d house %s\n",
 		day, self->get_id(),age,conception_sim_day,self->get_household()->get_label());
@@ -404,13 +423,7 @@ double Demographics::get_real_age() const {
 //////// Static Methods
 
 int Demographics::find_fips_code(int n) {
-  int size = Demographics::fips_codes.size();
-  for(int i = 0; i < size; ++i) {
-    if(Demographics::fips_codes[i] == n) {
-      return i;
-    }
-  }
-  return -1;
+  return Global::Places.get_index_of_county_with_fips(n);
 }
 
 void Demographics::update(int day) {
@@ -457,11 +470,12 @@ void Demographics::update(int day) {
 
 void Demographics::add_to_birthday_list(Person* person) {
   int day_of_year = person->get_demographics()->get_day_of_year_for_birthday_in_nonleap_year();
+  assert(person->get_demographics()->birthday_list_index == -1);
   Demographics::birthday_vecs[day_of_year].push_back(person);
   FRED_VERBOSE(2,
 	       "Adding person %d to birthday vector for day = %d.\n ... birthday_vecs[ %d ].size() = %zu\n",
 	       person->get_id(), day_of_year, day_of_year, Demographics::birthday_vecs[ day_of_year ].size());
-  Demographics::birthday_map[person] = (static_cast<int>(Demographics::birthday_vecs[day_of_year].size()) - 1);
+  person->get_demographics()->birthday_list_index = static_cast<int>(Demographics::birthday_vecs[day_of_year].size()) - 1;
 }
 
 void Demographics::delete_from_birthday_list(Person* person) {
@@ -471,25 +485,22 @@ void Demographics::delete_from_birthday_list(Person* person) {
 	       "deleting person %d to birthday vector for day = %d.\n ... birthday_vecs[ %d ].size() = %zu\n",
 	       person->get_id(), day_of_year, day_of_year, Demographics::birthday_vecs[ day_of_year ].size());
 
-  map<Person*, int>::iterator itr;
-  itr = Demographics::birthday_map.find(person);
-  if(itr == Demographics::birthday_map.end()) {
-    FRED_VERBOSE(0, "Help! person %d deleted, but not in the birthday_map\n",
+  int pos = person->get_demographics()->birthday_list_index;
+  if(pos == -1) {
+    FRED_VERBOSE(0, "Help! person %d deleted, but not in the birthday lists\n",
 		 person->get_id());
   }
-  assert(itr != Demographics::birthday_map.end());
-  int pos = (*itr).second;
+  assert(pos != -1);
+  assert(Demographics::birthday_vecs[day_of_year][pos] == person);
 
   // copy last person in birthday list into this person's slot
   Person* last = Demographics::birthday_vecs[day_of_year].back();
   Demographics::birthday_vecs[day_of_year][pos] = last;
-  Demographics::birthday_map[last] = pos;
+  last->get_demographics()->birthday_list_index = pos;
 
   // delete last slot
   Demographics::birthday_vecs[day_of_year].pop_back();
-
-  // delete from birthday map
-  Demographics::birthday_map.erase(itr);
+  person->get_demographics()->birthday_list_index = -1;
 
   FRED_VERBOSE(2,
 	       "deleted person %d to birthday vector for day = %d.\n ... birthday_vecs[ %d ].size() = %zu\n",
@@ -518,20 +529,12 @@ void Demographics::update_people_on_birthday_list(int day) {
 	       day, size);
   
   // make a temporary list of birthday people
-  std::vector<Person*> birthday_list;
-  birthday_list.reserve(size);
-  birthday_list.clear();
-  for(int p = 0; p < size; ++p) {
-    Person* person = Demographics::birthday_vecs[birthday_index][p];
-    birthday_list.push_back(person);
-  }
+  std::vector<Person*> birthday_list(Demographics::birthday_vecs[birthday_index]);
 
-  // update everyone on birthday list
-  int birthday_count = 0;
+  // the random draws use the shared stream, so birthdays are processed
+  // serially in list order; the output does not depend on the thread count
   for(int p = 0; p < size; ++p) {
-    Person* person = birthday_list[p];
-    person->birthday(day);
-    birthday_count++;
+    birthday_list[p]->birthday(day);
   }
 
   size = static_cast<int>(Demographics::birthday_vecs[birthday_index].size());
@@ -551,37 +554,21 @@ void Demographics::report(int day) {
   sprintf(filename, "%s/ages-%d.txt", Global::Simulation_directory, year);
   fp = fopen(filename, "w");
 
-  int n0, n5, n18, n65;
   int count[20];
   int total = 0;
-  n0 = n5 = n18 = n65 = 0;
   // age distribution
+  fred::Thread_Counts<int> age_counts(20);
+  Global::Pop.parallel_for([&](Person* person) {
+      int n = person->get_age() / 5;
+      if(n < 20) {
+	age_counts.add(n);
+      } else {
+	age_counts.add(19);
+      }
+    });
+  age_counts.get_totals(count);
   for(int c = 0; c < 20; ++c) {
-    count[c] = 0;
-  }
-  int current_popsize = Global::Pop.get_pop_size();
-  for(int p = 0; p < Global::Pop.get_index_size(); ++p) {
-    Person* person = Global::Pop.get_person_by_index(p);
-    if(person == NULL) {
-      continue;
-    }
-    int a = person->get_age();
-    if(a < 5) {
-      n0++;
-    } else if(a < 18) {
-      n5++;
-    } else if(a < 65) {
-      n18++;
-    } else {
-      n65++;
-    }
-    int n = a / 5;
-    if(n < 20) {
-      count[n]++;
-    } else {
-      count[19]++;
-    }
-    total++;
+    total += count[c];
   }
   // fprintf(fp, "\nAge distribution: %d people\n", total);
   for(int c = 0; c < 20; ++c) {
@@ -148,7 +148,22 @@ public:
   /**
    * Perform the necessary changes to the demographics on an agent's birthday
    */
-  void birthday(Person* self, int day);
+  void birthday(Person* self, int day) {
+    birthday(self, day, draw_birthday_events(self, day));
+  }
+
+  /**
+   * Make the random draws for an agent's birthday (will the agent die, or
+   * conceive, in the coming year?).
+   * @return the Birthday_event flags of the events that were drawn
+   */
+  int draw_birthday_events(Person* self, int day);
+
+  /**
+   * Perform the rest of the birthday changes, and schedule the events
+   * returned by draw_birthday_events
+   */
+  void birthday(Person* self, int day, int events);
 
   void set_number_of_children(int n) {
     this->number_of_children = n;
@@ -238,6 +253,13 @@ private:
   int deceased_sim_day;		   // When the agent (will die) / (died)
   int conception_sim_day;	  // When the agent will become pregnant
   int maternity_sim_day;	       // When the agent will give birth
+  int birthday_list_index;	// position in birthday_vecs, or -1
+
+  // events drawn by draw_birthday_events
+  enum {
+    BIRTHDAY_MORTALITY = 1,
+    BIRTHDAY_CONCEPTION = 2
+  };
 
   static int births_today;
   static int births_ytd;
@@ -247,9 +269,6 @@ private:
   static int total_deaths;
 
   static std::vector<Person*> birthday_vecs[367]; //0 won't be used | day 1 - 366
-  static std::map<Person*, int> birthday_map;
-
-  static std::vector<int> fips_codes;
 
 protected:
 
@@ -0,0 +1,320 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Event_Log.cc
+//
+
+#include <cstring>
+#include <sstream>
+#include <sys/types.h>
+
+#include "Event_Log.h"
+
+using namespace std;
+
+Infection_Event::Infection_Event() {
+  // zero the padding too, so that identical runs produce identical files
+  memset(this, 0, sizeof(Infection_Event));
+  this->infector_id = -1;
+  this->infector_age = -1;
+  this->infector_symptomatic = -1;
+  this->infector_sick_leave = -1;
+  this->infector_exposure_date = -1;
+  this->mixing_group_type = 'X';
+  this->mixing_group_subtype = 'X';
+  this->mixing_group_id = -1;
+  this->mixing_group_size = -1;
+  this->income = -1;
+  this->school_census_tract = -1;
+  this->distance = -1;
+  this->infector_census_tract = -1;
+  this->host_census_tract = -1;
+  strcpy(this->mixing_group_label, "NA");
+  strcpy(this->classroom_label, "NA");
+  strcpy(this->school_label, "NA");
+}
+
+void Infection_Event::print(std::ostream &out, int level, const char* disease_name) const {
+  out.precision(3);
+  out << fixed << "day " << this->day << " dis " << disease_name << " host " << this->host_id
+      << " age " << this->host_age
+      << " | DATES exp " << this->exposure_date
+      << " inf " << this->infectious_start_date << " " << this->infectious_end_date
+      << " symp " << this->symptoms_start_date << " " << this->symptoms_end_date
+      << " rec " << this->infectious_end_date << " sus " << this->immunity_end_date
+      << " infector_exp_date " << this->infector_exposure_date
+      << " | ";
+
+  if(level > 1) {
+    out << " sick_leave " << this->host_sick_leave
+        << " infector " << this->infector_id << " inf_age " << this->infector_age
+        << " inf_sympt " << this->infector_symptomatic << " inf_sick_leave " << this->infector_sick_leave
+        << " at " << this->mixing_group_type << " mixing_group " << this->mixing_group_id
+        << " subtype " << this->mixing_group_subtype << " mixing_group_lbl " << this->mixing_group_label;
+    out << " size " << this->mixing_group_size << " is_teacher " << this->is_teacher
+        << " is_student " << this->is_student << " total_infections " << this->total_infections;
+    if(this->mixing_group_type == 'S' || this->mixing_group_type == 'C') {
+      out << " sch_census_tract " << this->school_census_tract;
+    } else {
+      out << " sch_census_tract -1 ";
+    }
+    out << " income " << this->income;
+    out << " classroom_lbl " << this->classroom_label;
+    out << " school_lbl " << this->school_label;
+  }
+
+  if(level > 2) {
+    if(this->mixing_group_type != 'X' && this->infector_id != -1) {
+      out << " dist " << this->distance;
+    } else {
+      out << " dist -1 ";
+    }
+    if(this->infector_id == -1) {
+      out << " infctr_census_tract -1";
+      out << " host_census_tract -1";
+    } else {
+      out << " infctr_census_tract " << this->infector_census_tract;
+      out << " host_census_tract " << this->host_census_tract;
+    }
+    out << " | ";
+    if(this->is_place) {
+      if(this->mixing_group_type != 'X') {
+        out << " lat " << this->lat;
+        out << " lon " << this->lon;
+      } else {
+        out << " lat " << -999;
+        out << " lon " << -999;
+      }
+      out << " home_lat " << this->home_lat;
+      out << " home_lon " << this->home_lon;
+      out << " home_host_id " << this->home_label;
+      out << " home_inf_id " << this->infector_home_label;
+      out << " | ";
+    }
+  }
+
+  if(level > 3 && this->has_patch) {
+    out << " patch_lat " << this->patch_lat;
+    out << " patch_lon " << this->patch_lon;
+    out << " patch_pop " << this->patch_pop;
+    out << " | ";
+  }
+  out << "\n";
+}
+
+void Fatality_Event::print(std::ostream &out, const char* disease_name) const {
+  out.precision(3);
+  out << fixed << "day " << this->day << " dis " << disease_name << " host " << this->host_id
+      << " age " << this->host_age
+      << " | DATES exp " << this->exposure_date
+      << " inf " << this->infectious_start_date << " " << this->infectious_end_date
+      << " symp " << this->symptoms_start_date << " " << this->symptoms_end_date
+      << " dead " << this->day;
+  out << "\n";
+}
+
+void event_log_copy_label(char* dst, const char* src) {
+  strncpy(dst, src, EVENT_LOG_LABEL_SIZE - 1);
+  dst[EVENT_LOG_LABEL_SIZE - 1] = '\0';
+}
+
+Event_Log::Event_Log() {
+  this->fp = NULL;
+  this->record_size = 0;
+  this->done = false;
+}
+
+Event_Log::~Event_Log() {
+  close();
+}
+
+bool Event_Log::open(const char* filename, int record_type, int level) {
+  this->fp = fopen(filename, "wb");
+  if(this->fp == NULL) {
+    return false;
+  }
+  if(record_type == INFECTION_EVENTS) {
+    this->record_size = sizeof(Infection_Event);
+  } else {
+    this->record_size = sizeof(Fatality_Event);
+  }
+  Header header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header.magic, MAGIC(), sizeof(header.magic));
+  header.record_type = record_type;
+  header.record_size = this->record_size;
+  header.level = level;
+  fwrite(&header, sizeof(header), 1, this->fp);
+
+  this->current.reserve(buffer_size);
+  this->done = false;
+  this->writer = std::thread(&Event_Log::write_loop, this);
+  return true;
+}
+
+void Event_Log::append(const void* record) {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  const char* bytes = static_cast<const char*>(record);
+  this->current.insert(this->current.end(), bytes, bytes + this->record_size);
+  if(this->current.size() >= buffer_size) {
+    // bound the memory used if the disk can not keep up
+    while(this->pending.size() >= max_pending_buffers) {
+      this->work_finished.wait(lock);
+    }
+    enqueue_current_buffer();
+  }
+}
+
+void Event_Log::enqueue_current_buffer() {
+  // caller holds the mutex
+  if(this->current.empty()) {
+    return;
+  }
+  this->pending.push_back(std::vector<char>());
+  this->pending.back().swap(this->current);
+  this->current.reserve(buffer_size);
+  this->work_available.notify_one();
+}
+
+void Event_Log::flush() {
+  if(this->fp == NULL) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(this->mutex);
+  enqueue_current_buffer();
+}
+
+void Event_Log::write_loop() {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while(true) {
+    while(this->pending.empty() && !this->done) {
+      this->work_available.wait(lock);
+    }
+    if(this->pending.empty()) {
+      // done, and nothing left to write
+      break;
+    }
+    std::vector<char> buffer;
+    buffer.swap(this->pending.front());
+    this->pending.pop_front();
+    bool caught_up = this->pending.empty();
+    lock.unlock();
+    fwrite(&buffer[0], sizeof(char), buffer.size(), this->fp);
+    if(caught_up) {
+      fflush(this->fp);
+    }
+    lock.lock();
+    this->work_finished.notify_all();
+  }
+}
+
+void Event_Log::close() {
+  if(this->fp == NULL) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    enqueue_current_buffer();
+    this->done = true;
+    this->work_available.notify_one();
+  }
+  this->writer.join();
+
+  // disease names, followed by their offset
+  uint64_t names_offset = ftello(this->fp);
+  uint32_t count = this->names.size();
+  fwrite(&count, sizeof(uint32_t), 1, this->fp);
+  for(int i = 0; i < static_cast<int>(this->names.size()); ++i) {
+    uint32_t length = this->names[i].size();
+    fwrite(&length, sizeof(uint32_t), 1, this->fp);
+    fwrite(this->names[i].c_str(), sizeof(char), length, this->fp);
+  }
+  fwrite(&names_offset, sizeof(uint64_t), 1, this->fp);
+  fclose(this->fp);
+  this->fp = NULL;
+}
+
+bool Event_Log::convert_to_text(const char* filename, std::ostream &out) {
+  FILE* in = fopen(filename, "rb");
+  if(in == NULL) {
+    return false;
+  }
+  Header header;
+  if(fread(&header, sizeof(header), 1, in) != 1 || strncmp(header.magic, MAGIC(), sizeof(header.magic)) != 0) {
+    fclose(in);
+    return false;
+  }
+  if((header.record_type == INFECTION_EVENTS && header.record_size != sizeof(Infection_Event))
+     || (header.record_type == FATALITY_EVENTS && header.record_size != sizeof(Fatality_Event))
+     || (header.record_type != INFECTION_EVENTS && header.record_type != FATALITY_EVENTS)) {
+    fclose(in);
+    return false;
+  }
+
+  // find the end of the records and read the names; if the run did not
+  // finish, there are no names and the records run to the end of the file
+  fseeko(in, 0, SEEK_END);
+  uint64_t file_size = ftello(in);
+  uint64_t records_end = file_size;
+  vector<string> names;
+  uint64_t names_offset = 0;
+  if(file_size >= sizeof(header) + sizeof(uint64_t)) {
+    fseeko(in, file_size - sizeof(uint64_t), SEEK_SET);
+    if(fread(&names_offset, sizeof(uint64_t), 1, in) == 1 && names_offset >= sizeof(header)
+       && names_offset + sizeof(uint32_t) + sizeof(uint64_t) <= file_size
+       && (names_offset - sizeof(header)) % header.record_size == 0) {
+      fseeko(in, names_offset, SEEK_SET);
+      uint32_t count = 0;
+      bool ok = fread(&count, sizeof(uint32_t), 1, in) == 1;
+      for(uint32_t i = 0; ok && i < count; ++i) {
+        uint32_t length;
+        ok = fread(&length, sizeof(uint32_t), 1, in) == 1 && length < 1024;
+        if(ok) {
+          vector<char> name(length);
+          ok = length == 0 || fread(&name[0], sizeof(char), length, in) == length;
+          names.push_back(string(name.begin(), name.end()));
+        }
+      }
+      if(ok && (uint64_t)ftello(in) + sizeof(uint64_t) == file_size) {
+        records_end = names_offset;
+      } else {
+        names.clear();
+      }
+    }
+  }
+
+  fseeko(in, sizeof(header), SEEK_SET);
+  uint64_t number_of_records = (records_end - sizeof(header)) / header.record_size;
+  vector<char> record(header.record_size);
+  for(uint64_t n = 0; n < number_of_records; ++n) {
+    if(fread(&record[0], header.record_size, 1, in) != 1) {
+      break;
+    }
+    int disease_id = *reinterpret_cast<const int32_t*>(&record[sizeof(int32_t)]);
+    std::string disease_name;
+    if(0 <= disease_id && disease_id < static_cast<int>(names.size())) {
+      disease_name = names[disease_id];
+    } else {
+      std::stringstream ss;
+      ss << disease_id;
+      disease_name = ss.str();
+    }
+    if(header.record_type == INFECTION_EVENTS) {
+      reinterpret_cast<const Infection_Event*>(&record[0])->print(out, header.level, disease_name.c_str());
+    } else {
+      reinterpret_cast<const Fatality_Event*>(&record[0])->print(out, disease_name.c_str());
+    }
+  }
+  fclose(in);
+  return true;
+}
@@ -0,0 +1,218 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+//
+//
+// File: Event_Log.h
+//
+// Binary event logs, written instead of the text infections<n>.txt and
+// infectionsCF<n>.txt files when binary_event_log = 1.  Each event is a
+// fixed-width record that is copied into a buffer; full buffers are written
+// to disk by a background thread, so the simulation does not format text or
+// wait on the file system.  The fred_events utility converts a binary log
+// back to the text format.
+//
+// File layout:
+//
+//   [ header ][ record ][ record ]...[ names ][ names_offset (uint64_t) ]
+//
+// where names is the list of disease names (uint32_t count, then a uint32_t
+// length and the characters of each name), written when the log is closed.
+//
+#ifndef _FRED_EVENT_LOG_H
+#define _FRED_EVENT_LOG_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#define EVENT_LOG_LABEL_SIZE 32
+
+/*
+ * One transmission event (see Infection::report_infection).  Fields beyond
+ * the basic dates are only filled in at the track_infection_events level
+ * that prints them.
+ */
+struct Infection_Event {
+  int32_t day;
+  int32_t disease_id;
+  int32_t host_id;
+  int32_t exposure_date;
+  double host_age;
+  int32_t infectious_start_date;
+  int32_t infectious_end_date;
+  int32_t symptoms_start_date;
+  int32_t symptoms_end_date;
+  int32_t immunity_end_date;
+  int32_t infector_exposure_date;
+
+  // track_infection_events > 1
+  int32_t host_sick_leave;
+  int32_t infector_id;
+  double infector_age;
+  int32_t infector_symptomatic;
+  int32_t infector_sick_leave;
+  char mixing_group_type;
+  char mixing_group_subtype;
+  char is_place;
+  char has_patch;
+  int32_t mixing_group_id;
+  int32_t mixing_group_size;
+  int32_t is_teacher;
+  int32_t is_student;
+  int32_t total_infections;
+  int32_t income;
+  int64_t school_census_tract;
+  char mixing_group_label[EVENT_LOG_LABEL_SIZE];
+  char classroom_label[EVENT_LOG_LABEL_SIZE];
+  char school_label[EVENT_LOG_LABEL_SIZE];
+
+  // track_infection_events > 2
+  double distance;
+  int64_t infector_census_tract;
+  int64_t host_census_tract;
+  double lat;
+  double lon;
+  double home_lat;
+  double home_lon;
+  char home_label[EVENT_LOG_LABEL_SIZE];
+  char infector_home_label[EVENT_LOG_LABEL_SIZE];
+
+  // track_infection_events > 3
+  double patch_lat;
+  double patch_lon;
+  int32_t patch_pop;
+  int32_t unused;
+
+  Infection_Event();
+
+  /*
+   * Write the event exactly as it appears in the text infections file
+   */
+  void print(std::ostream &out, int level, const char* disease_name) const;
+};
+
+/*
+ * One case fatality event (see Infection::update)
+ */
+struct Fatality_Event {
+  int32_t day;
+  int32_t disease_id;
+  int32_t host_id;
+  int32_t exposure_date;
+  double host_age;
+  int32_t infectious_start_date;
+  int32_t infectious_end_date;
+  int32_t symptoms_start_date;
+  int32_t symptoms_end_date;
+
+  /*
+   * Write the event exactly as it appears in the text infectionsCF file
+   */
+  void print(std::ostream &out, const char* disease_name) const;
+};
+
+/*
+ * Copy a label into a fixed-width record field, truncating if necessary
+ */
+void event_log_copy_label(char* dst, const char* src);
+
+class Event_Log {
+public:
+
+  enum {
+    INFECTION_EVENTS = 1,
+    FATALITY_EVENTS = 2
+  };
+
+  struct Header {
+    char magic[16];
+    uint32_t record_type;
+    uint32_t record_size;
+    uint32_t level;
+    uint32_t reserved;
+  };
+
+  static const char* MAGIC() {
+    return "FRED EVENTS v01";
+  }
+
+  Event_Log();
+  ~Event_Log();
+
+  /**
+   * Create the log file and start the writer thread
+   * @param filename the output file
+   * @param record_type INFECTION_EVENTS or FATALITY_EVENTS
+   * @param level the track_infection_events level of the records
+   * @return false if the file can not be created
+   */
+  bool open(const char* filename, int record_type, int level);
+
+  /**
+   * Names of the diseases, written when the log is closed
+   */
+  void set_names(const std::vector<std::string> &names) {
+    this->names = names;
+  }
+
+  /**
+   * Append one record.  Safe to call from several threads at once.
+   */
+  void append(const void* record);
+
+  /**
+   * Hand the buffered records to the writer thread without waiting for them
+   * to be written
+   */
+  void flush();
+
+  /**
+   * Write any buffered records, the names and the trailer, and stop the writer thread
+   */
+  void close();
+
+  /**
+   * Reads a binary log and prints it in the text format
+   * @return false if the file is not a FRED event log
+   */
+  static bool convert_to_text(const char* filename, std::ostream &out);
+
+private:
+  void write_loop();
+  void enqueue_current_buffer();
+
+  static const size_t buffer_size = 1ul << 20;
+  static const size_t max_pending_buffers = 8;
+
+  FILE* fp;
+  size_t record_size;
+  std::vector<std::string> names;
+  std::vector<char> current;
+  std::deque< std::vector<char> > pending;
+  bool done;
+  std::mutex mutex;
+  std::condition_variable work_available;
+  std::condition_variable work_finished;
+  std::thread writer;
+
+  Event_Log(const Event_Log &);
+  void operator=(const Event_Log &);
+};
+
+#endif // _FRED_EVENT_LOG_H
@@ -22,6 +22,7 @@
 #include "Disease_List.h"
 #include "Evolution.h"
 #include "Epidemic.h"
+#include "Event_Log.h"
 #include "Fred.h"
 #include "Global.h"
 #include "Health.h"
@@ -178,6 +179,20 @@ void fred_setup(int argc, char* argv[]) {
   Global::Diseases.setup();
   Utils::fred_print_lap_time("Diseases.setup");
 
+  // binary event logs record disease ids; save the names for fred_events
+  if(Global::Infection_log != NULL || Global::InfectionCF_log != NULL) {
+    std::vector<std::string> disease_names;
+    for(int d = 0; d < Global::Diseases.get_number_of_diseases(); ++d) {
+      disease_names.push_back(Global::Diseases.get_disease(d)->get_disease_name());
+    }
+    if(Global::Infection_log != NULL) {
+      Global::Infection_log->set_names(disease_names);
+    }
+    if(Global::InfectionCF_log != NULL) {
+      Global::InfectionCF_log->set_names(disease_names);
+    }
+  }
+
   // read in the population and have each person enroll
   // in each daily activity location identified in the population file
   Utils::fred_print_wall_time("\nFRED Pop.setup started");
@@ -451,6 +466,11 @@ void fred_step(int day) {
   // needed -- see below)
   Activities::update(day);
 
+  // start and stop face masks scheduled for today
+  if(Global::Enable_Face_Mask_Usage) {
+    Health::update_face_masks(day);
+  }
+
   // shuffle the order of diseases to reduce systematic bias
   vector<int> order;
   order.clear();
@@ -499,9 +519,16 @@ void fred_step(int day) {
   {
 #pragma omp section
     {
-      // flush infections file buffer
+      // hand the infections file buffers to the background output thread
       fflush(Global::Infectionfp);
       fflush(Global::InfectionCFfp);
+      // binary logs are written by their own thread; just hand off today's events
+      if(Global::Infection_log != NULL) {
+        Global::Infection_log->flush();
+      }
+      if(Global::InfectionCF_log != NULL) {
+        Global::InfectionCF_log->flush();
+      }
     }
   }
 
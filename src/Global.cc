@@ -41,6 +41,7 @@ int Global::Quality_control = 0;
 int Global::RR_delay = 0;
 int Global::Track_infection_events = 0;
 bool Global::Track_fatality_events = 0;
+bool Global::Binary_event_log = false;
 char Global::Prevfilebase[FRED_STRING_SIZE];
 char Global::Incfilebase[FRED_STRING_SIZE];
 char Global::Immunityfilebase[FRED_STRING_SIZE];
@@ -176,6 +177,8 @@ FILE* Global::Outfp = NULL;
 FILE* Global::Tracefp = NULL;
 FILE* Global::Infectionfp = NULL;
 FILE* Global::InfectionCFfp = NULL;
+Event_Log* Global::Infection_log = NULL;
+Event_Log* Global::InfectionCF_log = NULL;
 FILE* Global::VaccineTracefp = NULL;
 FILE* Global::Birthfp = NULL;
 FILE* Global::Deathfp = NULL;
@@ -218,6 +221,8 @@ void Global::get_global_parameters() {
   Global::Enable_Behaviors = (temp_int == 0 ? false : true);
   Params::get_param_from_string("track_fatality_events", &temp_int);
   Global::Track_fatality_events = (temp_int == 0 ? false : true);
+  Params::get_param_from_string("binary_event_log", &temp_int);
+  Global::Binary_event_log = (temp_int == 0 ? false : true);
   Params::get_param_from_string("track_age_distribution", &temp_int);
   Global::Track_age_distribution = (temp_int == 0 ? false : true);
   Params::get_param_from_string("track_household_distribution", &temp_int);
@@ -62,6 +62,7 @@ class Vector_Layer;
 class Evolution;
 class Seasonality;
 class Sexual_Transmission_Network;
+class Event_Log;
 
 #include "Tracker.h"
 
@@ -207,6 +208,7 @@ public:
   static bool Enable_Behaviors;
   static int Track_infection_events;
   static bool Track_fatality_events;
+  static bool Binary_event_log;
   static bool Track_age_distribution;
   static bool Track_household_distribution;
   static bool Track_network_stats;
@@ -327,6 +329,8 @@ public:
   static FILE* Tracefp;
   static FILE* Infectionfp;
   static FILE* InfectionCFfp;
+  static Event_Log* Infection_log;
+  static Event_Log* InfectionCF_log;
   static FILE* VaccineTracefp;
   static FILE* Birthfp;
   static FILE* Deathfp;
@@ -573,6 +577,48 @@ namespace fred {
   typedef Mutex Spin_Mutex;
   typedef Scoped_Lock Spin_Lock;
 #endif
+
+  // Thread_Counts:
+  // Counters (or the bins of a histogram) that many threads add to at
+  // once, e.g. in Population::parallel_for.  Each thread adds to its own
+  // row of counts; the rows are padded so that no two threads write to the
+  // same cache line, and are summed when the totals are read.
+  template<typename T>
+  class Thread_Counts {
+  public:
+    explicit Thread_Counts(int _bins = 1) {
+      int per_line = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+      this->bins = _bins;
+      this->stride = ((_bins + per_line - 1) / per_line + 1) * per_line;
+      this->counts.assign(this->stride * omp_get_max_threads(), T());
+    }
+
+    void add(int bin, T value = 1) {
+      this->counts[omp_get_thread_num() * this->stride + bin] += value;
+    }
+
+    T get_total(int bin = 0) const {
+      T total = T();
+      for(int row = bin; row < (int)this->counts.size(); row += this->stride) {
+        total += this->counts[row];
+      }
+      return total;
+    }
+
+    /**
+     * Copies the total of each bin to totals, which must have room for all the bins
+     */
+    void get_totals(T* totals) const {
+      for(int bin = 0; bin < this->bins; ++bin) {
+        totals[bin] = get_total(bin);
+      }
+    }
+
+  private:
+    int bins;
+    int stride;
+    std::vector<T> counts;
+  };
 }
 
 typedef std::vector<Place*> place_vector_t;
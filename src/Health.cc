@@ -13,6 +13,7 @@
 //
 // File: Health.cc
 //
+#include <algorithm>
 #include <new>
 #include <stdexcept>
 
@@ -23,6 +24,7 @@
 #include "Date.h"
 #include "Disease.h"
 #include "Disease_List.h"
+#include "Events.h"
 #include "Evolution.h"
 #include "Infection.h"
 #include "Health.h"
@@ -72,11 +74,56 @@ Age_Map* Health::pregnancy_case_fatality_prob_mult = NULL;
 
 bool Health::is_initialized = false;
 
+// Vaccine_Health and AV_Health records are handed out from large chunks
+// instead of being allocated one at a time, and the records of persons who
+// die are reused.  Vaccination and antiviral campaigns are processed
+// serially, so the pools need no locking.
+namespace {
+
+  template<typename Record>
+  class Record_Pool {
+  public:
+    Record_Pool() : chunk(NULL), next_free(0) { }
+
+    void* get_free() {
+      if(!this->free_records.empty()) {
+        void* record = this->free_records.back();
+        this->free_records.pop_back();
+        return record;
+      }
+      if(this->chunk == NULL || this->next_free == block_size) {
+        this->chunk = static_cast<Record*>(::operator new(sizeof(Record) * block_size));
+        this->next_free = 0;
+      }
+      return &(this->chunk[this->next_free++]);
+    }
+
+    void release(Record* record) {
+      record->~Record();
+      this->free_records.push_back(record);
+    }
+
+  private:
+    static const int block_size = 4096;
+    Record* chunk;
+    int next_free;
+    std::vector<Record*> free_records;
+  };
+
+  Record_Pool<Vaccine_Health> vaccine_health_pool;
+  Record_Pool<AV_Health> av_health_pool;
+}
+
 // health protective behavior parameters
 int Health::Min_age_wear_face_masks = 0;
 int Health::Days_to_wear_face_masks = 0;
 int Health::Day_start_wearing_face_masks = 0;
 std::unordered_map<string,double> Health::Face_mask_compliance;
+std::vector<string> Health::Face_mask_locations;
+std::vector<double> Health::Face_mask_location_compliance;
+int Health::Face_mask_symptomatic_only = 0;
+Events* Health::Face_mask_start_queue = NULL;
+Events* Health::Face_mask_stop_queue = NULL;
 double Health::Hand_washing_compliance = 0.0;
 
 double Health::Hh_income_susc_mod_floor = 0.0;
@@ -120,6 +167,21 @@ void Health::initialize_static_variables() {
       Utils::fred_abort("there should always be a location called \"other\"");
     }
 
+    // each location gets one bit of a person's face_mask_locations, in the
+    // order the compliance draws are made
+    if(Face_mask_compliance.size() > 8 * sizeof(unsigned int)) {
+      Utils::fred_abort("at most %d face_mask_locations are allowed\n", (int) (8 * sizeof(unsigned int)));
+    }
+    for(auto it = Face_mask_compliance.begin(); it != Face_mask_compliance.end(); ++it) {
+      Face_mask_locations.push_back(it->first);
+      Face_mask_location_compliance.push_back(it->second);
+    }
+    if(Global::Enable_Face_Mask_Usage) {
+      Params::get_param_from_string("face_mask_symptomatic_only", &(Health::Face_mask_symptomatic_only));
+      Health::Face_mask_start_queue = new Events();
+      Health::Face_mask_stop_queue = new Events();
+    }
+
     Params::get_param_from_string("hand_washing_compliance", &(Health::Hand_washing_compliance));
 
     int temp_int = 0;
@@ -269,16 +331,76 @@ double Health::get_chronic_condition_hospitalization_prob_mult(double real_age,
   return 1.0;
 }
 
+double Health::get_max_chronic_condition_hospitalization_mult() {
+  if(!Global::Enable_Chronic_Condition || !Health::is_initialized || !has_chronic_condition()) {
+    return 1.0;
+  }
+  Age_Map* maps[] = {
+    Health::asthma_hospitalization_prob_mult,
+    Health::COPD_hospitalization_prob_mult,
+    Health::chronic_renal_disease_hospitalization_prob_mult,
+    Health::diabetes_hospitalization_prob_mult,
+    Health::heart_disease_hospitalization_prob_mult,
+    Health::hypertension_hospitalization_prob_mult,
+    Health::hypercholestrolemia_hospitalization_prob_mult
+  };
+  double max_mult = 1.0;
+  for(int i = 0; i < Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS; ++i) {
+    if(has_chronic_condition(i)) {
+      max_mult *= std::max(1.0, maps[i]->get_max_value());
+    }
+  }
+  // the agent may become pregnant later
+  return max_mult * std::max(1.0, Health::pregnancy_hospitalization_prob_mult->get_max_value());
+}
+
+bool Health::is_clinical_risk_profile_stale() {
+  return this->risk_profile_age != this->myself->get_age()
+    || this->risk_profile_pregnant != this->myself->get_demographics()->is_pregnant();
+}
+
+void Health::update_clinical_risk_profile() {
+  int age = this->myself->get_age();
+  bool pregnant = this->myself->get_demographics()->is_pregnant();
+  double hospitalization_mult = 1.0;
+  double case_fatality_mult = 1.0;
+  // pregnancy only modifies the risk of agents who have a chronic condition
+  if(has_chronic_condition()) {
+    for(int i = 0; i < Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS; ++i) {
+      if(has_chronic_condition(i)) {
+        Chronic_condition_index::e cond_idx = static_cast<Chronic_condition_index::e>(i);
+        hospitalization_mult *= Health::get_chronic_condition_hospitalization_prob_mult(age, cond_idx);
+        case_fatality_mult *= Health::get_chronic_condition_case_fatality_prob_mult(age, cond_idx);
+      }
+    }
+    if(pregnant) {
+      hospitalization_mult *= Health::get_pregnancy_hospitalization_prob_mult(age);
+      case_fatality_mult *= Health::get_pregnancy_case_fatality_prob_mult(age);
+    }
+  }
+  this->chronic_hospitalization_mult = hospitalization_mult;
+  this->chronic_case_fatality_mult = case_fatality_mult;
+  this->risk_profile_age = age;
+  this->risk_profile_pregnant = pregnant;
+}
+
 Health::Health() {
   this->myself = NULL;
+  this->chronic_conditions = 0;
+  this->risk_profile_age = -1;
+  this->risk_profile_pregnant = false;
+  this->chronic_hospitalization_mult = 1.0;
+  this->chronic_case_fatality_mult = 1.0;
   this->past_infections = NULL;
   this->alive = true;
   this->av_health = NULL;
+  this->av_takers_index = -1;
   this->checked_for_av = NULL;
   this->vaccine_health = NULL;
-  this->has_face_mask_behavior_anywhere = false;
+  this->face_mask_locations = 0;
   this->wears_face_mask_today = false;
-  this->days_wearing_face_mask = 0;
+  this->face_mask_state = FACE_MASK_NONE;
+  this->face_mask_date = -1;
   this->washes_hands = false;
   this->days_symptomatic = 0;
   this->days_hospitalization = 0;
@@ -320,9 +442,10 @@ void Health::setup(Person* self) {
   }
   
   // Facemasks defaults
-  this->has_face_mask_behavior_anywhere = false;
+  this->face_mask_locations = 0;
   this->wears_face_mask_today = false;
-  this->days_wearing_face_mask = 0;
+  this->face_mask_state = FACE_MASK_NONE;
+  this->face_mask_date = -1;
   
   this->case_fatality = fred::disease_bitset();
   int diseases = Global::Diseases.get_number_of_diseases();
@@ -371,6 +494,7 @@ void Health::setup(Person* self) {
   this->days_hospitalization = 0;
   this->vaccine_health = NULL;
   this->av_health = NULL;
+  this->av_takers_index = -1;
   this->checked_for_av = NULL;
   this->previous_infection_serotype = -1;
 
@@ -410,20 +534,16 @@ Health::~Health() {
     }
   }
 
-  if(this->vaccine_health) {
-    for(unsigned int i = 0; i < this->vaccine_health->size(); ++i) {
-      delete (*this->vaccine_health)[i];
-    }
-    this->vaccine_health->clear();
-    delete this->vaccine_health;
+  while(this->vaccine_health != NULL) {
+    Vaccine_Health* next = this->vaccine_health->get_next();
+    vaccine_health_pool.release(this->vaccine_health);
+    this->vaccine_health = next;
   }
 
-  if(this->av_health) {
-    for(unsigned int i = 0; i < this->av_health->size(); ++i) {
-      delete (*this->av_health)[i];
-    }
-    this->av_health->clear();
-    delete this->av_health;
+  while(this->av_health != NULL) {
+    AV_Health* next = this->av_health->get_next();
+    av_health_pool.release(this->av_health);
+    this->av_health = next;
   }
 
   if(this->checked_for_av) {
@@ -544,6 +664,7 @@ void Health::become_exposed(int disease_id, Person* infector, Mixing_Group* mixi
   this->infectious.reset(disease_id);
   this->symptomatic.reset(disease_id);
   this->hospitalized.reset(disease_id);
+  myself->update_household_composition();
   Disease* disease = Global::Diseases.get_disease(disease_id);
   this->infection[disease_id] = Infection::get_new_infection(disease, infector, myself, mixing_group, day);
   FRED_VERBOSE(1, "setup infection: person %d dis_id %d day %d\n", myself->get_id(), disease_id, day);
@@ -586,6 +707,7 @@ void Health::become_exposed(int disease_id, Person* infector, Mixing_Group* mixi
       this->immunity.reset(dis_i);
       become_unsusceptible(Global::Diseases.get_disease(dis_i));      
     }
+    myself->update_household_composition();
   }
   if(Global::Enable_Vector_Transmission && Global::Diseases.get_number_of_diseases() > 1) {
     // special check for multi-serotype dengue:
@@ -650,29 +772,22 @@ void Health::become_infectious(Disease* disease) {
     If facemasks enabled, then decide if will wear facemasks 
   */
 
-  // Determine if the agent will wear a face mask
+  // Determine where the agent will wear a face mask
   if(Global::Enable_Face_Mask_Usage == true && myself->get_age() >= Health::Min_age_wear_face_masks){
-    if(Global::Enable_Face_Mask_Timeseries_File == true){
-      for (auto it = Face_mask_compliance.begin(); it != Face_mask_compliance.end(); ++it) {
-	double tmp_compliance = Global::Places.get_face_mask_compliance_today(it->first);
-	//printf("Health.cc::BECOME_INFECTIOUS. Compliance %lf location %s\n", tmp_compliance, it->first.c_str());
-	if(tmp_compliance > 0.0 && Random::draw_random() < tmp_compliance){
-	  this->has_face_mask_behavior[it->first] = true;
-	  this->has_face_mask_behavior_anywhere = true;
-	}else{
-	  this->has_face_mask_behavior[it->first] = false;
-	}
+    this->face_mask_locations = 0;
+    int locations = Health::Face_mask_locations.size();
+    for(int loc = 0; loc < locations; ++loc) {
+      double compliance = Health::Face_mask_location_compliance[loc];
+      if(Global::Enable_Face_Mask_Timeseries_File == true){
+	compliance = Global::Places.get_face_mask_compliance_today(Health::Face_mask_locations[loc]);
       }
-    }else{
-      for (auto it = Face_mask_compliance.begin(); it != Face_mask_compliance.end(); ++it) {  
-	if((it->second > 0.0) && Random::draw_random() < it->second) {
-	  this->has_face_mask_behavior[it->first] = true;
-	  this->has_face_mask_behavior_anywhere = true;
-	} else {
-	  this->has_face_mask_behavior[it->first] = false;
-	}
+      if(compliance > 0.0 && Random::draw_random() < compliance) {
+	this->face_mask_locations |= (1u << loc);
       }
     }
+    if(this->face_mask_locations != 0 && !Health::Face_mask_symptomatic_only) {
+      schedule_face_mask(Global::Simulation_Day);
+    }
   }
 }
 
@@ -700,10 +815,14 @@ void Health::become_symptomatic(Disease* disease) {
     return;
   }
   this->symptomatic.set(disease_id);
+  myself->update_household_composition();
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d is SYMPTOMATIC for disease %d\n",
 			  Date::get_date_string().c_str(),
 			  myself->get_id(), disease_id);
+  if(this->face_mask_locations != 0 && Health::Face_mask_symptomatic_only) {
+    schedule_face_mask(Global::Simulation_Day);
+  }
 }
 
 void Health::become_hospitalized(Disease* disease) {
@@ -732,6 +851,12 @@ void Health::resolve_symptoms(Disease* disease) {
   // assert(this->infection[disease_id] != NULL);
   if(this->symptomatic.test(disease_id)) {
     this->symptomatic.reset(disease_id);
+    myself->update_household_composition();
+  }
+  // masks worn only while symptomatic come off when the symptoms do
+  if(Health::Face_mask_symptomatic_only && this->face_mask_state == FACE_MASK_WORN && !is_symptomatic()) {
+    Health::Face_mask_stop_queue->delete_event(this->face_mask_date, myself);
+    stop_wearing_face_mask(Global::Simulation_Day);
   }
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d RESOLVES SYMPTOMS for disease %d\n",
@@ -780,6 +905,7 @@ void Health::become_removed(int disease_id, int day) {
   this->infectious.reset(disease_id);
   this->symptomatic.reset(disease_id);
   this->hospitalized.reset(disease_id);
+  myself->update_household_composition();
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			   "HEALTH CHART: %s person %d is REMOVED for disease %d\n",
 			   Date::get_date_string().c_str(),
@@ -795,6 +921,7 @@ void Health::become_immune(Disease* disease) {
   this->infectious.reset(disease_id);
   this->symptomatic.reset(disease_id);
   this->hospitalized.reset(disease_id);
+  myself->update_household_composition();
   FRED_CONDITIONAL_VERBOSE(0, Global::Enable_Health_Charts,
 			  "HEALTH CHART: %s person %d is IMMUNE for disease %d\n",
 			  Date::get_date_string().c_str(),
@@ -862,10 +989,6 @@ void Health::become_case_fatality(int disease_id, int day) {
 
 void Health::update_infection(int day, int disease_id) {
   
-  if(this->has_face_mask_behavior_anywhere) {
-    update_face_mask_decision(day, disease_id);
-  }
-  
   if(this->infection[disease_id] == NULL) {
     return;
   }
@@ -901,50 +1024,117 @@ void Health::update_infection(int day, int disease_id) {
 } // end Health::update_infection //
 
 
-void Health::update_face_mask_decision(int day, int disease_id) {
-  // printf("update_face_mask_decision entered on day %d for person %d\n", day, myself->get_id());
-  Disease* disease = Global::Diseases.get_disease(disease_id);
+void Health::schedule_face_mask(int day) {
+  // each agent takes up a face mask at most once
+  if(this->face_mask_state != FACE_MASK_NONE || Health::Days_to_wear_face_masks <= 0) {
+    return;
+  }
+  if(Health::Day_start_wearing_face_masks <= day) {
+    start_wearing_face_mask(day);
+  } else {
+    this->face_mask_state = FACE_MASK_SCHEDULED;
+    this->face_mask_date = Health::Day_start_wearing_face_masks;
+    Health::Face_mask_start_queue->add_event(this->face_mask_date, myself);
+  }
+}
 
-  /*
-    IF TIMESTEP IS NOT BEING READ, then use basic model, 
-    IF TIMESTEP BEING READ, then go to Global::Places and get the daily probability
-  */
-  
-  // should we start use face mask?
-  if((!disease->get_face_mask_symptomatic_only() || this->is_symptomatic(day))
-     && this->days_wearing_face_mask == 0
-     && this->Day_start_wearing_face_masks <= day) {
-    FRED_VERBOSE(1, "FACEMASK: person %d starts wearing face mask on day %d\n", myself->get_id(), day);
-    this->start_wearing_face_mask();
-  }
-
-  // should we stop using face mask?
-  if(this->is_wearing_face_mask()) {
-    if ((!disease->get_face_mask_symptomatic_only() || this->is_symptomatic(day))
-	&& this->days_wearing_face_mask < Health::Days_to_wear_face_masks) {
-      this->days_wearing_face_mask++;
+void Health::start_wearing_face_mask(int day) {
+  FRED_VERBOSE(1, "FACEMASK: person %d starts wearing face mask on day %d\n", myself->get_id(), day);
+  this->wears_face_mask_today = true;
+  this->face_mask_state = FACE_MASK_WORN;
+  this->face_mask_date = day + Health::Days_to_wear_face_masks;
+  Health::Face_mask_stop_queue->add_event(this->face_mask_date, myself);
+}
+
+void Health::stop_wearing_face_mask(int day) {
+  FRED_VERBOSE(1, "FACEMASK: person %d stops wearing face mask on day %d\n", myself->get_id(), day);
+  this->wears_face_mask_today = false;
+  this->face_mask_state = FACE_MASK_DONE;
+  this->face_mask_date = -1;
+}
+
+void Health::update_face_masks(int day) {
+  int size = Health::Face_mask_start_queue->get_size(day);
+  for(int i = 0; i < size; ++i) {
+    Health* health = Health::Face_mask_start_queue->get_event(day, i)->get_health();
+    // start only if still infectious (or symptomatic); otherwise a later
+    // infection may schedule it again
+    if(Health::Face_mask_symptomatic_only ? health->is_symptomatic() : health->infectious.any()) {
+      health->start_wearing_face_mask(day);
     } else {
-      FRED_VERBOSE(1, "FACEMASK: person %d stops wearing face mask on day %d\n", myself->get_id(), day);
-      this->stop_wearing_face_mask();
+      health->face_mask_state = FACE_MASK_NONE;
+      health->face_mask_date = -1;
+    }
+  }
+  Health::Face_mask_start_queue->clear_events(day);
+
+  size = Health::Face_mask_stop_queue->get_size(day);
+  for(int i = 0; i < size; ++i) {
+    Health::Face_mask_stop_queue->get_event(day, i)->get_health()->stop_wearing_face_mask(day);
+  }
+  Health::Face_mask_stop_queue->clear_events(day);
+}
+
+int Health::find_face_mask_location(Place* place) {
+  string names[3] = { place->get_household_type(), place->get_place_subtype(), place->get_place_type() };
+  for(int i = 0; i < 3; ++i) {
+    std::vector<string>::iterator itr = std::find(Face_mask_locations.begin(), Face_mask_locations.end(), names[i]);
+    if(itr != Face_mask_locations.end()) {
+      return itr - Face_mask_locations.begin();
     }
   }
+  return std::find(Face_mask_locations.begin(), Face_mask_locations.end(), "other") - Face_mask_locations.begin();
+}
+
+bool Health::is_wearing_face_mask_at(Place* place) {
+  if(!this->wears_face_mask_today) {
+    return false;
+  }
+  int loc = place->get_face_mask_location();
+  if(loc < 0) {
+    // places created after Place_List::prepare
+    loc = Health::find_face_mask_location(place);
+  }
+  return (this->face_mask_locations >> loc) & 1u;
 }
 
-void Health::update_vaccine_interventions(int day){
+void Health::process_vaccine_event(int day, int event, int record, Vaccine_Manager* vm){
   if(!(this->alive)) {
     return;
   }
-  if(this->intervention_flags[Intervention_flag::TAKES_VACCINE]) {
-    int size = (int)(this->vaccine_health->size());
-    for(int i = 0; i < size; ++i) {
-      (*this->vaccine_health)[i]->update(day, myself->get_real_age());
-    }
-  }  
+  if(!this->intervention_flags[Intervention_flag::TAKES_VACCINE]) {
+    return;
+  }
+  // only the vaccination that scheduled the event
+  Vaccine_Health* vh = get_vaccine_health(record);
+  if(vh == NULL) {
+    return;
+  }
+  switch(event) {
+  case Vaccine_event::NEXT_DOSE:
+    vh->advance_dose(day, myself, vm);
+    break;
+  case Vaccine_event::IMMUNITY_START:
+    vh->become_immune(day, myself);
+    break;
+  case Vaccine_event::SYMPTOMS_IMMUNITY_START:
+    vh->become_immune_to_symptoms(day, myself);
+    break;
+  case Vaccine_event::HOSPITALIZATION_IMMUNITY_START:
+    vh->become_immune_to_hospitalization(day, myself);
+    break;
+  case Vaccine_event::IMMUNITY_END:
+    vh->lose_immunity(day, myself);
+    break;
+  case Vaccine_event::HOSPITALIZATION_IMMUNITY_END:
+    vh->lose_immunity_to_hospitalization(day, myself);
+    break;
+  }
 }
 
 int Health::is_vaccine_effective_any() const{
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->is_effective_any();
+    return this->vaccine_health->is_effective_any();
   }else{
     return -1;
   }
@@ -952,7 +1142,7 @@ int Health::is_vaccine_effective_any() const{
 
 int Health::get_vaccination_any_effective_day() const{
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->get_vaccination_any_effective_day();
+    return this->vaccine_health->get_vaccination_any_effective_day();
     }else{
     return -1;
   }
@@ -960,7 +1150,7 @@ int Health::get_vaccination_any_effective_day() const{
 
 int Health::get_vaccination_effective_day() const{
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->get_vaccination_effective_day();
+    return this->vaccine_health->get_vaccination_effective_day();
     }else{
     return -1;
   }
@@ -968,7 +1158,7 @@ int Health::get_vaccination_effective_day() const{
 
 int Health::get_vaccination_symp_effective_day() const{
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->get_vaccination_symp_effective_day();
+    return this->vaccine_health->get_vaccination_symp_effective_day();
     }else{
     return -1;
   }
@@ -976,7 +1166,7 @@ int Health::get_vaccination_symp_effective_day() const{
 
 int Health::get_vaccination_hosp_effective_day() const{
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->get_vaccination_hosp_effective_day();
+    return this->vaccine_health->get_vaccination_hosp_effective_day();
     }else{
     return -1;
   }
@@ -984,7 +1174,7 @@ int Health::get_vaccination_hosp_effective_day() const{
 
 int Health::get_vaccination_immunity_loss_day() const {
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->get_vaccine_immunity_loss_day();
+    return this->vaccine_health->get_vaccine_immunity_loss_day();
   }else{
     return -1;
   }
@@ -992,7 +1182,7 @@ int Health::get_vaccination_immunity_loss_day() const {
 
 int Health::get_vaccination_hosp_immunity_loss_day() const {
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->get_vaccine_hosp_immunity_loss_day();
+    return this->vaccine_health->get_vaccine_hosp_immunity_loss_day();
   }else{
     return -1;
   }
@@ -1007,8 +1197,8 @@ void Health::update_interventions(int day) {
   //if(this->intervention_flags.any()) {
   // update antiviral status
   if(this->intervention_flags[Intervention_flag::TAKES_AV]) {
-    for(av_health_itr i = this->av_health->begin(); i != this->av_health->end(); ++i) {
-      (*i)->update(day);
+    for(AV_Health* av = this->av_health; av != NULL; av = av->get_next()) {
+      av->update(day, this);
     }
   }
 } // end Health::update_interventions
@@ -1176,23 +1366,7 @@ double Health::get_susceptibility_modifier_due_to_person_age(int disease_id, int
 
 double Health::get_transmission_modifier_due_to_hygiene(int disease_id, Place* place) {
   Disease* disease = Global::Diseases.get_disease(disease_id);
-  bool face_mask_here = false;
-  if (disease->is_face_mask_usage_enabled()) {
-    if (this->is_wearing_face_mask()) {
-      string loc_type(place->get_place_type());
-      string loc_subtype(place->get_place_subtype());
-      string loc_hhtype(place->get_household_type());
-      if (this->has_face_mask_behavior.count(loc_hhtype) == 1) {
-	face_mask_here = this->has_face_mask_behavior[loc_hhtype];
-      } else if (this->has_face_mask_behavior.count(loc_subtype) == 1) {
-	face_mask_here = this->has_face_mask_behavior[loc_subtype];
-      } else if (this->has_face_mask_behavior.count(loc_type) == 1) {
-	face_mask_here = this->has_face_mask_behavior[loc_type];
-      } else {
-	face_mask_here = this->has_face_mask_behavior["other"];
-      }
-    }
-  }
+  bool face_mask_here = disease->is_face_mask_usage_enabled() && is_wearing_face_mask_at(place);
   if(face_mask_here && disease->is_hand_washing_enabled() && this->is_washing_hands()) {
     return (1.0 - disease->get_face_mask_plus_hand_washing_transmission_efficacy());
   }
@@ -1218,23 +1392,7 @@ double Health::get_susceptibility_modifier_due_to_hygiene(int disease_id) {
 double Health::get_infection_modifier_face_masks_odds_ratio(int disease_id, double infection_prob,
 							    Place* place) {
   Disease* disease = Global::Diseases.get_disease(disease_id);
-  bool face_mask_here = false;
-  if (disease->is_face_mask_usage_enabled()) {
-    if (this->is_wearing_face_mask()) {
-      string loc_type(place->get_place_type());
-      string loc_subtype(place->get_place_subtype());
-      string loc_hhtype(place->get_household_type());
-      if (this->has_face_mask_behavior.count(loc_hhtype) == 1) {
-	face_mask_here = this->has_face_mask_behavior[loc_hhtype];
-      } else if (this->has_face_mask_behavior.count(loc_subtype) == 1) {
-	face_mask_here = this->has_face_mask_behavior[loc_subtype];
-      } else if (this->has_face_mask_behavior.count(loc_type) == 1) {
-	face_mask_here = this->has_face_mask_behavior[loc_type];
-      } else {
-	face_mask_here = this->has_face_mask_behavior["other"];
-      }
-    }
-  }
+  bool face_mask_here = disease->is_face_mask_usage_enabled() && is_wearing_face_mask_at(place);
   if(face_mask_here) {
     return (1/((1-infection_prob)/disease->get_face_mask_transmission_efficacy() + infection_prob));
   }
@@ -1298,27 +1456,31 @@ void Health::modify_develops_symptoms(int disease_id, bool symptoms, int cur_day
 
     this->infection[disease_id]->modify_develops_symptoms(symptoms, cur_day);
     this->symptomatic.set(disease_id);
+    myself->update_household_composition();
   }
 }
 int Health::get_current_vaccine_dose(int i){
-  if(this->vaccine_health) {
-    return (*this->vaccine_health)[i]->get_current_dose();
+  Vaccine_Health* vh = get_vaccine_health(i);
+  if(vh != NULL) {
+    return vh->get_current_dose();
   } else {
     return -1;
   }
 }
 
 int Health::get_days_to_next_dose(int i){
-   if(this->vaccine_health) {
-    return (*this->vaccine_health)[i]->get_days_to_next_dose();
+  Vaccine_Health* vh = get_vaccine_health(i);
+  if(vh != NULL) {
+    return vh->get_days_to_next_dose();
   } else {
     return -1;
   }
 }
 
 int Health::get_next_dose_mix_match(int i){
-   if(this->vaccine_health) {
-    return (*this->vaccine_health)[i]->get_next_dose_mix_match();
+  Vaccine_Health* vh = get_vaccine_health(i);
+  if(vh != NULL) {
+    return vh->get_next_dose_mix_match();
   } else {
     return -1;
   }
@@ -1330,28 +1492,35 @@ void Health::take_vaccine(Vaccine* vaccine, int day, Vaccine_Manager* vm) {
   double real_age = myself->get_real_age();
   // Is this our first dose?
   Vaccine_Health * vaccine_health_for_dose = NULL;
+  Vaccine_Health * last = NULL;
+  int number_of_vaccines = 0;
 
-  if(this->vaccine_health == NULL) {
-    this->vaccine_health = new vaccine_health_type();
-  }
-
-  for(unsigned int ivh = 0; ivh < this->vaccine_health->size(); ++ivh) {
-    if((*this->vaccine_health)[ivh]->get_vaccine() == vaccine) {
-      vaccine_health_for_dose = (*this->vaccine_health)[ivh];
+  for(Vaccine_Health* vh = this->vaccine_health; vh != NULL; vh = vh->get_next()) {
+    if(vh->get_vaccine() == vaccine) {
+      vaccine_health_for_dose = vh;
     }
+    last = vh;
+    number_of_vaccines++;
   }
   
   if(vaccine_health_for_dose == NULL) { // This is our first dose of this vaccine
-    this->vaccine_health->push_back(new Vaccine_Health(day, vaccine, real_age, myself, vm));
+    Vaccine_Health* vh = new (vaccine_health_pool.get_free()) Vaccine_Health(day, vaccine, real_age, myself, vm, number_of_vaccines);
+    if(last == NULL) {
+      this->vaccine_health = vh;
+    } else {
+      last->set_next(vh);
+    }
+    last = vh;
+    number_of_vaccines++;
     this->intervention_flags[Intervention_flag::TAKES_VACCINE] = true;
   } else { // Already have a dose, need to take the next dose
-    vaccine_health_for_dose->update_for_next_dose(day, real_age);
+    vaccine_health_for_dose->update_for_next_dose(day, real_age, myself, vm);
   }
 
   if(Global::VaccineTracefp != NULL) {
     fprintf(Global::VaccineTracefp, " id %7d vaccid %3d vaccine health %d", myself->get_id(),
-	    (*this->vaccine_health)[this->vaccine_health->size() - 1]->get_vaccine()->get_ID(), this->vaccine_health->size());
-    (*this->vaccine_health)[this->vaccine_health->size() - 1]->printTrace();
+	    last->get_vaccine()->get_ID(), number_of_vaccines);
+    last->printTrace(myself);
     fprintf(Global::VaccineTracefp, "\n");
   }
   
@@ -1363,27 +1532,67 @@ void Health::take(Antiviral* av, int day) {
     this->checked_for_av = new checked_for_av_type();
     this->checked_for_av->assign(nantivirals, false);
   }
+  AV_Health* av_health_for_course = new (av_health_pool.get_free()) AV_Health(day, av);
   if(this->av_health == NULL) {
-    this->av_health = new av_health_type();
+    this->av_health = av_health_for_course;
+  } else {
+    AV_Health* last = this->av_health;
+    while(last->get_next() != NULL) {
+      last = last->get_next();
+    }
+    last->set_next(av_health_for_course);
+  }
+  if(!this->intervention_flags[Intervention_flag::TAKES_AV]) {
+    this->intervention_flags[Intervention_flag::TAKES_AV] = true;
+    Global::Pop.add_av_taker(myself);
   }
-  this->av_health->push_back(new AV_Health(day, av, this));
-  this->intervention_flags[Intervention_flag::TAKES_AV] = true;
   return;
 }
 
 bool Health::is_on_av_for_disease(int day, int d) const {
-  for(unsigned int iav = 0; iav < this->av_health->size(); ++iav) {
-    if((*this->av_health)[iav]->get_disease() == d
-       && (*this->av_health)[iav]->is_on_av(day)) {
+  for(AV_Health* av = this->av_health; av != NULL; av = av->get_next()) {
+    if(av->get_disease() == d && av->is_on_av(day)) {
       return true;
     }
   }
   return false;
 }
 
+int Health::get_number_av_taken() const {
+  int n = 0;
+  for(AV_Health* av = this->av_health; av != NULL; av = av->get_next()) {
+    n++;
+  }
+  return n;
+}
+
+AV_Health* Health::get_av_health(int i) const {
+  AV_Health* av = this->av_health;
+  for(; i > 0 && av != NULL; --i) {
+    av = av->get_next();
+  }
+  assert(av != NULL);
+  return av;
+}
+
 int Health::get_av_start_day(int i) const {
-  assert(this->av_health != NULL);
-  return (*this->av_health)[i]->get_av_start_day();
+  return get_av_health(i)->get_av_start_day();
+}
+
+int Health::get_number_vaccines_taken() const {
+  int n = 0;
+  for(Vaccine_Health* vh = this->vaccine_health; vh != NULL; vh = vh->get_next()) {
+    n++;
+  }
+  return n;
+}
+
+Vaccine_Health* Health::get_vaccine_health(int i) const {
+  Vaccine_Health* vh = this->vaccine_health;
+  for(; i > 0 && vh != NULL; --i) {
+    vh = vh->get_next();
+  }
+  return vh;
 }
 
 void Health::infect(Person* infectee, int disease_id, Mixing_Group* mixing_group, int day) {
@@ -1450,6 +1659,13 @@ void Health::terminate(int day) {
       Global::Diseases.get_disease(disease_id)->terminate_person(myself, day);
     }
   }
+  // remove pending face mask events
+  if(this->face_mask_state == FACE_MASK_SCHEDULED) {
+    Health::Face_mask_start_queue->delete_event(this->face_mask_date, myself);
+  } else if(this->face_mask_state == FACE_MASK_WORN) {
+    Health::Face_mask_stop_queue->delete_event(this->face_mask_date, myself);
+  }
+  this->face_mask_state = FACE_MASK_DONE;
   this->alive = false;
 }
 
@@ -1463,7 +1679,7 @@ void Health::update_health_conditions(int day) {
 
 int Health::get_vaccinated_id() const {
   if(this->vaccine_health){
-    return (*this->vaccine_health)[0]->get_vaccine()->get_ID();
+    return this->vaccine_health->get_vaccine()->get_ID();
   }else{
     return -1;
   }
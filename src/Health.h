@@ -32,7 +32,9 @@ class Antivirals;
 class AV_Health;
 class AV_Manager;
 class Disease;
+class Events;
 class Person;
+class Place;
 class Mixing_Group;
 class Vaccine;
 class Vaccine_Health;
@@ -95,9 +97,8 @@ public:
   // UPDATE THE PERSON'S HEALTH CONDITIONS
 
   void update_infection(int day, int disease_id);
-  void update_face_mask_decision(int day, int disease_id);
   void update_interventions(int day);
-  void update_vaccine_interventions(int day);
+  void process_vaccine_event(int day, int event, int record, Vaccine_Manager* vm);
   void become_exposed(int disease_id, Person* infector, Mixing_Group* mixing_group, int day);
   void become_susceptible(int disease_id);
   void become_susceptible_by_natural_waning(int disease_id);
@@ -123,12 +124,6 @@ public:
   void advance_seed_infection(int disease_id, int days_to_advance);
   void infect(Person* infectee, int disease_id, Mixing_Group* mixing_group, int day);
   //  void increment_infectee_count(int disease_id, Person* infectee, Mixing_Group* mixing_group, int day);
-  void start_wearing_face_mask() {
-    this->wears_face_mask_today = true;
-  }
-  void stop_wearing_face_mask() {
-    this->wears_face_mask_today = false;
-  }
   void clear_past_infections(int disease_id) {
     this->past_infections[disease_id].clear();
   }
@@ -278,16 +273,28 @@ public:
   void take(Antiviral* av, int day);
 
   /**
-   * @return a count of the antivirals this agent has already taken
+   * @return true if this agent has taken any antiviral
    */
-  int get_number_av_taken() const {
-    if(this->av_health) {
-      return this->av_health->size();
-    } else {
-      return 0;
-    }
+  bool takes_av() const {
+    return this->intervention_flags[Intervention_flag::TAKES_AV];
   }
 
+  /**
+   * @return this agent's position in the population's list of antiviral takers, or -1
+   */
+  int get_av_takers_index() const {
+    return this->av_takers_index;
+  }
+
+  void set_av_takers_index(int index) {
+    this->av_takers_index = index;
+  }
+
+  /**
+   * @return a count of the antivirals this agent has already taken
+   */
+  int get_number_av_taken() const;
+
   /**
    * @param s the index of the av to check
    * @return the checked_for_av with the given index
@@ -313,11 +320,7 @@ public:
    * @return <code>true</code> if the agent is vaccinated, <code>false</code> if not
    */
   bool is_vaccinated() const {
-    if(this->vaccine_health) {
-      return this->vaccine_health->size();
-    } else {
-      return 0;
-    }
+    return this->vaccine_health != NULL;
   }
 
   int get_vaccinated_id() const;    
@@ -333,21 +336,12 @@ public:
   /**
    * @return the number of vaccines this agent has taken
    */
-  int get_number_vaccines_taken() const {
-    if(this->vaccine_health) {
-      return this->vaccine_health->size();
-    } else {
-      return 0;
-    }
-  }
+  int get_number_vaccines_taken() const;
 
   /**
    * @return a pointer to this instance's AV_Health object
    */
-  AV_Health* get_av_health(int i) const {
-    assert(this->av_health != NULL);
-    return (*this->av_health)[i];
-  }
+  AV_Health* get_av_health(int i) const;
 
   /**
    * @return this instance's av_start day
@@ -357,13 +351,7 @@ public:
   /**
    * @return a pointer to this instance's Vaccine_Health object
    */
-  Vaccine_Health* get_vaccine_health(int i) const {
-    if(this->vaccine_health) {
-      return (*this->vaccine_health)[i];
-    } else {
-      return NULL;
-    }
-  }
+  Vaccine_Health* get_vaccine_health(int i) const;
 
   int get_current_vaccine_dose(int i);
   int get_days_to_next_dose(int i);
@@ -543,19 +531,13 @@ public:
   }
 
   /*
-   * @return <code>true</code> if the map contains the condition and it is true,
-   *  <code>false</code> otherwise
+   * @return <code>true</code> if the agent has the condition, <code>false</code> otherwise
    * @param cond_idx the Chronic_condition_index to search for
    */
   bool has_chronic_condition(int cond_idx) {
     assert(cond_idx >= static_cast<int>(Chronic_condition_index::ASTHMA));
     assert(cond_idx < static_cast<int>(Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS));
-    if(this->chronic_conditions_map.find(static_cast<Chronic_condition_index::e>(cond_idx))
-       != this->chronic_conditions_map.end()) {
-      return this->chronic_conditions_map[static_cast<Chronic_condition_index::e>(cond_idx)];
-    } else {
-      return false;
-    }
+    return (this->chronic_conditions & (1 << cond_idx)) != 0;
   }
 
   /*
@@ -566,20 +548,46 @@ public:
   void set_has_chronic_condition(Chronic_condition_index::e cond_idx, bool has_cond) {
     assert(cond_idx >= Chronic_condition_index::ASTHMA);
     assert(cond_idx < Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS);
-    this->chronic_conditions_map[cond_idx] = has_cond;
+    if(has_cond) {
+      this->chronic_conditions |= (1 << cond_idx);
+    } else {
+      this->chronic_conditions &= ~(1 << cond_idx);
+    }
+    // the risk multipliers depend on the conditions
+    this->risk_profile_age = -1;
   }
 
   /*
-   * @return <code>true</code> if the map contains any condition and it that condition is true,
+   * @return <code>true</code> if the agent has any chronic condition,
    *  <code>false</code> otherwise
    */
   bool has_chronic_condition() {
-    for(int i = 0; i < Chronic_condition_index::CHRONIC_MEDICAL_CONDITIONS; ++i) {
-      if(has_chronic_condition(i)) {
-        return true;
-      }
+    return this->chronic_conditions != 0;
+  }
+
+  /*
+   * The product of the hospitalization (and outpatient healthcare) probability
+   * multipliers for the agent's chronic conditions and pregnancy.  Cached, and
+   * recomputed only when the agent's age, pregnancy or conditions change.
+   * @return the combined multiplier (1.0 if the agent has no chronic condition)
+   */
+  double get_chronic_condition_hospitalization_mult() {
+    if(is_clinical_risk_profile_stale()) {
+      update_clinical_risk_profile();
     }
-    return false;
+    return this->chronic_hospitalization_mult;
+  }
+
+  /*
+   * The product of the case fatality probability multipliers for the agent's
+   * chronic conditions and pregnancy.  Cached like the hospitalization multiplier.
+   * @return the combined multiplier (1.0 if the agent has no chronic condition)
+   */
+  double get_chronic_condition_case_fatality_mult() {
+    if(is_clinical_risk_profile_stale()) {
+      update_clinical_risk_profile();
+    }
+    return this->chronic_case_fatality_mult;
   }
 
   // HEALTH INSURANCE
@@ -600,6 +608,17 @@ public:
    * Initialize any static variables needed by the Health class
    */
   static void initialize_static_variables();
+
+  /**
+   * Start and stop the face masks scheduled for today
+   */
+  static void update_face_masks(int day);
+
+  /**
+   * @return the index of the face_mask_locations entry that applies to the place:
+   * its household type, subtype or type, in that order, or else "other"
+   */
+  static int find_face_mask_location(Place* place);
     
   static const char* chronic_condition_lookup(Chronic_condition_index::e idx) {
     assert(idx >= 0);
@@ -670,6 +689,11 @@ public:
 
   static Insurance_assignment_index::e get_health_insurance_from_distribution();
 
+  /**
+   * @return an upper bound on get_chronic_condition_hospitalization_mult() for this agent at any age
+   */
+  double get_max_chronic_condition_hospitalization_mult();
+
   static double get_chronic_condition_case_fatality_prob_mult(double real_age, Chronic_condition_index::e cond_idx);
   static double get_chronic_condition_hospitalization_prob_mult(double real_age, Chronic_condition_index::e cond_idx);
 
@@ -772,25 +796,45 @@ private:
   // when not in use
   typedef std::vector<bool> checked_for_av_type;
   checked_for_av_type* checked_for_av;
-  typedef std::vector<AV_Health*> av_health_type;
-  av_health_type* av_health;
-  typedef std::vector<AV_Health*>::iterator av_health_itr;
+  // AV_Health records form a list in the order taken; the records come
+  // from a shared pool (see Health.cc)
+  AV_Health* av_health;
+  int av_takers_index;	// position in Population::av_takers, or -1
 
-  // Vaccines.  These are all dynamically allocated to save space
-  // when not in use
-  typedef std::vector<Vaccine_Health*> vaccine_health_type;
-  vaccine_health_type* vaccine_health;
-  typedef std::vector<Vaccine_Health*>::iterator vaccine_health_itr;
+  // Vaccines.  Vaccine_Health records form a list in the order taken,
+  // allocated from a shared pool when first needed
+  Vaccine_Health* vaccine_health;
 
   // health behaviors
-  bool has_face_mask_behavior_anywhere;
-  std::unordered_map<string,bool> has_face_mask_behavior;
+  enum {
+    FACE_MASK_NONE,
+    FACE_MASK_SCHEDULED,
+    FACE_MASK_WORN,
+    FACE_MASK_DONE
+  };
+  unsigned int face_mask_locations;  // one bit per entry of Face_mask_locations
   bool wears_face_mask_today;
-  int days_wearing_face_mask;
+  unsigned char face_mask_state;
+  int face_mask_date;                // start date if scheduled, stop date if worn
+
+  void schedule_face_mask(int day);
+  void start_wearing_face_mask(int day);
+  void stop_wearing_face_mask(int day);
+  bool is_wearing_face_mask_at(Place* place);
   bool washes_hands;				// every day
 
-  // current chronic conditions
-  std::map<Chronic_condition_index::e, bool> chronic_conditions_map;
+  // current chronic conditions, one bit per Chronic_condition_index
+  unsigned char chronic_conditions;
+
+  // clinical risk profile: cached products of the chronic condition
+  // multipliers, valid for the age and pregnancy status they were computed at
+  bool risk_profile_pregnant;
+  short risk_profile_age;
+  double chronic_hospitalization_mult;
+  double chronic_case_fatality_mult;
+
+  bool is_clinical_risk_profile_stale();
+  void update_clinical_risk_profile();
 
   //Insurance Type
   Insurance_assignment_index::e insurance_type;
@@ -840,6 +884,11 @@ private:
   static int Min_age_wear_face_masks;
   static int Day_start_wearing_face_masks;
   static std::unordered_map<string,double> Face_mask_compliance;  
+  static std::vector<string> Face_mask_locations;
+  static std::vector<double> Face_mask_location_compliance;
+  static int Face_mask_symptomatic_only;
+  static Events* Face_mask_start_queue;
+  static Events* Face_mask_stop_queue;
   static double Hand_washing_compliance;
 
   static double Hh_income_susc_mod_floor;
@@ -50,6 +50,7 @@ Hospital::Hospital() : Place() {
   this->occupied_bed_count = 0;
   this->daily_patient_capacity = -1;
   this->current_daily_patient_count = 0;
+  this->daily_patient_count_day = -1;
   this->add_capacity = false;
 
   if(Global::Enable_Health_Insurance) {
@@ -86,6 +87,7 @@ Hospital::Hospital(const char* lab, char _subtype, fred::geo lon, fred::geo lat)
   this->occupied_bed_count = 0;
   this->daily_patient_capacity = -1;
   this->current_daily_patient_count = 0;
+  this->daily_patient_count_day = -1;
   this->add_capacity = false;
 
   if(Global::Enable_Health_Insurance) {
@@ -116,15 +116,28 @@ public:
   }
 
   int get_current_daily_patient_count() {
+    update_daily_patient_count_day();
     return this->current_daily_patient_count;
   }
 
   void increment_current_daily_patient_count() {
+    update_daily_patient_count_day();
     this->current_daily_patient_count++;
   }
 
   void reset_current_daily_patient_count() {
     this->current_daily_patient_count = 0;
+    this->daily_patient_count_day = Place::Daily_counts_day;
+  }
+
+  /**
+   * Under HAZEL the daily patient count is reset the first time it is used
+   * on a new day, instead of resetting every hospital each day.
+   */
+  void update_daily_patient_count_day() {
+    if(Global::Enable_HAZEL && this->daily_patient_count_day != Place::Daily_counts_day) {
+      reset_current_daily_patient_count();
+    }
   }
 
   int get_occupied_bed_count() {
@@ -172,6 +185,7 @@ private:
   int occupied_bed_count;
   int daily_patient_capacity;
   int current_daily_patient_count;
+  int daily_patient_count_day;       // Place::Daily_counts_day of current_daily_patient_count (HAZEL)
   bool add_capacity;
   bool HAZEL_closure_dates_have_been_set;
 
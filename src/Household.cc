@@ -61,10 +61,9 @@ Household::Household() : Place() {
   this->sheltering_by_age = false;
   this->shelter_age_min = 0;
   this->shelter_age_max = 120;
-  this->hh_schl_aged_chld_unemplyd_adlt_chng = false;
-  this->hh_schl_aged_chld = false;
-  this->hh_schl_aged_chld_unemplyd_adlt = false;
-  this->hh_sympt_child = false;
+  this->school_aged_children = 0;
+  this->symptomatic_school_aged_children = 0;
+  this->adult_caregivers = 0;
   this->hh_working_adult_using_sick_leave = false;
   this->seeking_healthcare = false;
   this->primary_healthcare_available = true;
@@ -73,6 +72,7 @@ Household::Household() : Place() {
   this->count_seeking_hc = 0;
   this->count_primary_hc_unav = 0;
   this->count_hc_accept_ins_unav = 0;
+  this->healthcare_info_day = -1;
   this->shelter_start_day = 0;  
   this->shelter_end_day = 0;
   this->shelter_by_age_end_day = 0;
@@ -93,10 +93,9 @@ Household::Household(const char* lab, char _subtype, fred::geo lon, fred::geo la
   this->sheltering_by_age = false;
   this->shelter_age_min = 0;
   this->shelter_age_max = 120;
-  this->hh_schl_aged_chld_unemplyd_adlt_chng = false;
-  this->hh_schl_aged_chld = false;
-  this->hh_schl_aged_chld_unemplyd_adlt = false;
-  this->hh_sympt_child = false;
+  this->school_aged_children = 0;
+  this->symptomatic_school_aged_children = 0;
+  this->adult_caregivers = 0;
   this->hh_working_adult_using_sick_leave = false;
   this->seeking_healthcare = false;
   this->primary_healthcare_available = true;
@@ -105,6 +104,7 @@ Household::Household(const char* lab, char _subtype, fred::geo lon, fred::geo la
   this->count_seeking_hc = 0;
   this->count_primary_hc_unav = 0;
   this->count_hc_accept_ins_unav = 0;
+  this->healthcare_info_day = -1;
   this->shelter_start_day = 0;
   this->shelter_end_day = 0;
   this->shelter_by_age_end_day = 0;
@@ -174,7 +174,6 @@ double Household::get_contacts_per_day(int disease) {
 }
 
 void Household::set_household_has_hospitalized_member(bool does_have) {
-  this->hh_schl_aged_chld_unemplyd_adlt_chng = true;
   if(does_have) {
     this->not_home_bitset[Household_extended_absence_index::HAS_HOSPITALIZED] = true;
   } else {
@@ -195,70 +194,88 @@ void Household::set_household_has_hospitalized_member(bool does_have) {
   }
 }
 
+int Household::enroll(Person* per) {
+  int pos = Place::enroll(per);
+  unsigned char flags = Household::get_composition_flags(per);
+  per->get_activities()->set_household_composition(flags);
+  this->school_aged_children += (flags & Household_composition::SCHOOL_AGED_CHILD) != 0;
+  this->symptomatic_school_aged_children += (flags & Household_composition::SYMPTOMATIC_SCHOOL_AGED_CHILD) != 0;
+  this->adult_caregivers += (flags & Household_composition::ADULT_CAREGIVER) != 0;
+  return pos;
+}
+
+void Household::unenroll(int pos) {
+  Person* per = this->enrollees[pos];
+  unsigned char flags = per->get_activities()->get_household_composition();
+  this->school_aged_children -= (flags & Household_composition::SCHOOL_AGED_CHILD) != 0;
+  this->symptomatic_school_aged_children -= (flags & Household_composition::SYMPTOMATIC_SCHOOL_AGED_CHILD) != 0;
+  this->adult_caregivers -= (flags & Household_composition::ADULT_CAREGIVER) != 0;
+  per->get_activities()->set_household_composition(0);
+  Place::unenroll(pos);
+}
+
+void Household::update_composition(Person* per) {
+  unsigned char old_flags = per->get_activities()->get_household_composition();
+  unsigned char flags = Household::get_composition_flags(per);
+  if(flags == old_flags) {
+    return;
+  }
+  per->get_activities()->set_household_composition(flags);
+  this->school_aged_children += ((flags & Household_composition::SCHOOL_AGED_CHILD) != 0)
+    - ((old_flags & Household_composition::SCHOOL_AGED_CHILD) != 0);
+  this->symptomatic_school_aged_children += ((flags & Household_composition::SYMPTOMATIC_SCHOOL_AGED_CHILD) != 0)
+    - ((old_flags & Household_composition::SYMPTOMATIC_SCHOOL_AGED_CHILD) != 0);
+  this->adult_caregivers += ((flags & Household_composition::ADULT_CAREGIVER) != 0)
+    - ((old_flags & Household_composition::ADULT_CAREGIVER) != 0);
+  assert(this->school_aged_children >= 0);
+  assert(this->symptomatic_school_aged_children >= 0);
+  assert(this->adult_caregivers >= 0);
+}
+
 bool Household::has_school_aged_child() {
   //Household has been loaded
   assert(Global::Pop.is_load_completed());
-  //If the household status hasn't changed, just return the flag
-  if(!this->hh_schl_aged_chld_unemplyd_adlt_chng) {
-    return this->hh_schl_aged_chld;
-  } else {
-    bool ret_val = false;
-    for(int i = 0; i < static_cast<int>(this->enrollees.size()); ++i) {
-      Person* per = this->enrollees[i];
-      if(per->is_student() && per->is_child()) {
-        ret_val = true;
-        break;
-      }
-    }
-    this->hh_schl_aged_chld = ret_val;
-    this->hh_schl_aged_chld_unemplyd_adlt_chng = false;
-    return ret_val;
-  }
+  return this->school_aged_children > 0;
 }
 
 bool Household::has_school_aged_child_and_unemployed_adult() {
   //Household has been loaded
   assert(Global::Pop.is_load_completed());
-  //If the household status hasn't changed, just return the flag
-  if(!this->hh_schl_aged_chld_unemplyd_adlt_chng) {
-    return this->hh_schl_aged_chld_unemplyd_adlt;
-  } else {
-    bool ret_val = false;
-    if(has_school_aged_child()) {
-      for(int i = 0; i < static_cast<int>(this->enrollees.size()); ++i) {
-        Person* per = this->enrollees[i];
-        if(per->is_child()) {
-          continue;
-        }
-
-        //Person is an adult, but is also a student
-        if(per->is_adult() && per->is_student()) {
-          continue;
-        }
-
-        //Person is an adult, but isn't at home
-        if(per->is_adult() &&
-           (per->is_hospitalized() ||
-            per->is_college_dorm_resident() ||
-            per->is_military_base_resident() ||
-            per->is_nursing_home_resident() ||
-            per->is_prisoner())) {
-          continue;
-        }
+  return this->school_aged_children > 0 && this->adult_caregivers > 0;
+}
 
-        //Person is an adult AND is either retired or unemployed
-        if(per->is_adult() &&
-           (per->get_activities()->get_profile() == RETIRED_PROFILE ||
-            per->get_activities()->get_profile() == UNEMPLOYED_PROFILE)) {
-          ret_val = true;
-          break;
-        }
+unsigned char Household::get_composition_flags(Person* per) {
+  unsigned char flags = 0;
+  if(per->is_child()) {
+    if(per->is_student()) {
+      flags |= Household_composition::SCHOOL_AGED_CHILD;
+      if(per->is_symptomatic()) {
+        flags |= Household_composition::SYMPTOMATIC_SCHOOL_AGED_CHILD;
       }
     }
-    this->hh_schl_aged_chld_unemplyd_adlt = ret_val;
-    this->hh_schl_aged_chld_unemplyd_adlt_chng = false;
-    return ret_val;
+    return flags;
   }
+
+  //Person is an adult, but is also a student
+  if(per->is_student()) {
+    return flags;
+  }
+
+  //Person is an adult, but isn't at home
+  if(per->is_hospitalized() ||
+     per->is_college_dorm_resident() ||
+     per->is_military_base_resident() ||
+     per->is_nursing_home_resident() ||
+     per->is_prisoner()) {
+    return flags;
+  }
+
+  //Person is an adult AND is either retired or unemployed
+  char profile = per->get_activities()->get_profile();
+  if(profile == RETIRED_PROFILE || profile == UNEMPLOYED_PROFILE) {
+    flags |= Household_composition::ADULT_CAREGIVER;
+  }
+  return flags;
 }
 
 void Household::prepare_person_childcare_sickleave_map() {
@@ -267,6 +284,14 @@ void Household::prepare_person_childcare_sickleave_map() {
 
   if(Global::Report_Childhood_Presenteeism) {
     if(has_school_aged_child() && !has_school_aged_child_and_unemployed_adult()) {
+      // the school-aged children, found once for all of the adults
+      std::vector<Person*> children;
+      for(int j = 0; j < static_cast<int>(this->enrollees.size()); ++j) {
+        Person* child_check = this->enrollees[j];
+        if(child_check->get_activities()->get_household_composition() & Household_composition::SCHOOL_AGED_CHILD) {
+          children.push_back(child_check);
+        }
+      }
       for(int i = 0; i < static_cast<int>(this->enrollees.size()); ++i) {
         Person* per = this->enrollees[i];
         if(per->is_child()) {
@@ -296,11 +321,8 @@ void Household::prepare_person_childcare_sickleave_map() {
           HH_Adult_Sickleave_Data sickleave_info;
 
           //Add any school-aged children to that person's info
-          for(int j = 0; j < static_cast<int>(this->enrollees.size()); ++j) {
-            Person* child_check = this->enrollees[j];
-            if(child_check->is_student() && child_check->is_child()) {
-              sickleave_info.add_child_to_maps(child_check);
-            }
+          for(int j = 0; j < static_cast<int>(children.size()); ++j) {
+            sickleave_info.add_child_to_maps(children[j]);
           }
           std::pair<std::map<Person*, HH_Adult_Sickleave_Data>::iterator, bool> ret;
           ret = this->adult_childcare_sickleave_map.insert(
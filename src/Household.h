@@ -61,6 +61,18 @@ namespace Household_extended_absence_index {
   };
 };
 
+/**
+ * The following enum defines bit flags for the way a household member
+ * counts toward the composition of the household.
+ */
+namespace Household_composition {
+  enum e {
+    SCHOOL_AGED_CHILD = 1,              // child who is a student
+    SYMPTOMATIC_SCHOOL_AGED_CHILD = 2,  // and is symptomatic
+    ADULT_CAREGIVER = 4                 // retired or unemployed adult living at home
+  };
+};
+
 /**
  * The following enum defines symbolic names for places that
  * members of this household may visit.
@@ -180,6 +192,33 @@ public:
    */
   double get_contacts_per_day(int disease);
 
+  /**
+   * @see Mixing_Group::enroll(Person* per)
+   *
+   * Also adds the person to the household composition counts.
+   */
+  int enroll(Person* per);
+
+  /**
+   * @see Mixing_Group::unenroll(int pos)
+   *
+   * Also removes the person from the household composition counts.
+   */
+  void unenroll(int pos);
+
+  /**
+   * Recount a member of this household after a change in age, profile or
+   * symptoms.
+   * @param per a person enrolled in this household
+   */
+  void update_composition(Person* per);
+
+  /**
+   * @param per a person
+   * @return the Household_composition flags of the person
+   */
+  static unsigned char get_composition_flags(Person* per);
+
   /**
    * Use to get list of all people in the household.
    * @return vector of pointers to people in household.
@@ -339,26 +378,32 @@ public:
   }
 
   void set_is_primary_healthcare_available(bool _primary_healthcare_available) {
+    update_healthcare_info_day();
     this->primary_healthcare_available = _primary_healthcare_available;
   }
 
   bool is_primary_healthcare_available() {
+    update_healthcare_info_day();
     return this->primary_healthcare_available;
   }
 
   void set_other_healthcare_location_that_accepts_insurance_available(bool _other_healthcare_location_that_accepts_insurance_available) {
+    update_healthcare_info_day();
     this->other_healthcare_location_that_accepts_insurance_available = _other_healthcare_location_that_accepts_insurance_available;
   }
 
   bool is_other_healthcare_location_that_accepts_insurance_available() {
+    update_healthcare_info_day();
     return this->other_healthcare_location_that_accepts_insurance_available;
   }
 
   void set_is_healthcare_available(bool _healthcare_available) {
+    update_healthcare_info_day();
     this->healthcare_available = _healthcare_available;
   }
 
   bool is_healthcare_available() {
+    update_healthcare_info_day();
     return this->healthcare_available;
   }
 
@@ -394,16 +439,8 @@ public:
   bool has_school_aged_child();
   bool has_school_aged_child_and_unemployed_adult();
 
-  void set_sympt_child(bool _hh_sympt_childl) {
-    this->hh_sympt_child = _hh_sympt_childl;
-  }
-
   bool has_sympt_child() {
-    return this->hh_sympt_child;
-  }
-
-  void set_hh_schl_aged_chld_unemplyd_adlt_chng(bool _hh_status_changed) {
-    this->hh_schl_aged_chld_unemplyd_adlt_chng = _hh_status_changed;
+    return this->symptomatic_school_aged_children > 0;
   }
 
   void set_working_adult_using_sick_leave(bool _is_using_sl) {
@@ -428,36 +465,54 @@ public:
   }
 
   int get_count_seeking_hc() {
+    update_healthcare_info_day();
     return this->count_seeking_hc;
   }
 
   void set_count_seeking_hc(int _count_seeking_hc) {
+    update_healthcare_info_day();
     this->count_seeking_hc = _count_seeking_hc;
   }
 
   int get_count_primary_hc_unav() {
+    update_healthcare_info_day();
     return this->count_primary_hc_unav;
   }
 
   void set_count_primary_hc_unav(int _count_primary_hc_unav) {
+    update_healthcare_info_day();
     this->count_primary_hc_unav = _count_primary_hc_unav;
   }
 
   int get_count_hc_accept_ins_unav() {
+    update_healthcare_info_day();
     return this->count_hc_accept_ins_unav;
   }
 
   void set_count_hc_accept_ins_unav(int _count_hc_accept_ins_unav) {
+    update_healthcare_info_day();
     this->count_hc_accept_ins_unav = _count_hc_accept_ins_unav;
   }
 
   void reset_healthcare_info() {
-    this->set_is_primary_healthcare_available(true);
-    this->set_other_healthcare_location_that_accepts_insurance_available(true);
-    this->set_is_healthcare_available(true);
-    this->set_count_seeking_hc(0);
-    this->set_count_primary_hc_unav(0);
-    this->set_count_hc_accept_ins_unav(0);
+    this->primary_healthcare_available = true;
+    this->other_healthcare_location_that_accepts_insurance_available = true;
+    this->healthcare_available = true;
+    this->count_seeking_hc = 0;
+    this->count_primary_hc_unav = 0;
+    this->count_hc_accept_ins_unav = 0;
+    this->healthcare_info_day = Place::Daily_counts_day;
+  }
+
+  /**
+   * Under HAZEL the daily healthcare info starts each day reset.  Rather than
+   * resetting every household each day, the info is stamped with the day it
+   * belongs to and reset the first time it is used on a later day.
+   */
+  void update_healthcare_info_day() {
+    if(Global::Enable_HAZEL && this->healthcare_info_day != Place::Daily_counts_day) {
+      reset_healthcare_info();
+    }
   }
 
   static int get_min_hh_income() {
@@ -505,13 +560,14 @@ private:
   int count_seeking_hc;
   int count_primary_hc_unav;
   int count_hc_accept_ins_unav;
+  int healthcare_info_day;            // Place::Daily_counts_day of the healthcare info above (HAZEL)
   int shelter_age_min;
   int shelter_age_max;
   
-  bool hh_schl_aged_chld_unemplyd_adlt_chng;
-  bool hh_schl_aged_chld;
-  bool hh_schl_aged_chld_unemplyd_adlt;
-  bool hh_sympt_child;
+  // household composition, updated as members enroll, unenroll or change
+  int school_aged_children;
+  int symptomatic_school_aged_children;
+  int adult_caregivers;
   bool hh_working_adult_using_sick_leave;
 
   unsigned char deme_id;	      // deme == synthetic population id
@@ -13,6 +13,7 @@
 
 
 #include "Disease.h"
+#include "Event_Log.h"
 #include "Global.h"
 #include "HIV_Infection.h"
 #include "Markov_Infection.h"
@@ -300,85 +301,82 @@ void Infection::print() {
 }
 
 void Infection::report_infection(int day) {
-  if(Global::Infectionfp == NULL) {
+  if(Global::Infectionfp == NULL && Global::Infection_log == NULL) {
     return;
   }
 
-  int mixing_group_id = (this->mixing_group == NULL ? -1 : this->mixing_group->get_id());
-  string mixing_group_label = (this->mixing_group == NULL ? "NA" : string(this->mixing_group->get_label()));
-  char mixing_group_type = (this->mixing_group == NULL ? 'X' : this->mixing_group->get_type());
-  char mixing_group_subtype = 'X';
-  if(this->mixing_group != NULL && dynamic_cast<Place*>(this->mixing_group) != NULL) {
-    Place* place = dynamic_cast<Place*>(this->mixing_group);
-    if(place->is_group_quarters()) {
-      if(place->is_college()) {
-        mixing_group_subtype = 'D';
-      }
-      if(place->is_prison()) {
-        mixing_group_subtype = 'J';
-      }
-      if(place->is_nursing_home()) {
-        mixing_group_subtype = 'L';
-      }
-      if(place->is_military_base()) {
-        mixing_group_subtype = 'B';
-      }
+  Infection_Event event;
+  event.day = day;
+  event.disease_id = this->disease->get_id();
+  event.host_id = this->host->get_id();
+  event.host_age = this->host->get_real_age();
+  event.exposure_date = this->exposure_date;
+  event.infectious_start_date = get_infectious_start_date();
+  event.infectious_end_date = get_infectious_end_date();
+  event.symptoms_start_date = get_symptoms_start_date();
+  event.symptoms_end_date = get_symptoms_end_date();
+  event.immunity_end_date = get_immunity_end_date();
+  event.infector_exposure_date = (this->infector == NULL ? -1 : this->infector->get_exposure_date(this->disease->get_id()));
+  event.infector_id = (this->infector == NULL ? -1 : this->infector->get_id());
+
+  Place* place = (this->mixing_group == NULL ? NULL : dynamic_cast<Place*>(this->mixing_group));
+  event.is_place = (place != NULL);
+  if(this->mixing_group != NULL) {
+    event.mixing_group_id = this->mixing_group->get_id();
+    event_log_copy_label(event.mixing_group_label, this->mixing_group->get_label());
+    event.mixing_group_type = this->mixing_group->get_type();
+    event.mixing_group_size = this->mixing_group->get_container_size();
+  }
+  if(place != NULL && place->is_group_quarters()) {
+    if(place->is_college()) {
+      event.mixing_group_subtype = 'D';
+    }
+    if(place->is_prison()) {
+      event.mixing_group_subtype = 'J';
+    }
+    if(place->is_nursing_home()) {
+      event.mixing_group_subtype = 'L';
+    }
+    if(place->is_military_base()) {
+      event.mixing_group_subtype = 'B';
     }
   }
-  int mixing_group_size = (this->mixing_group == NULL ? -1 : this->mixing_group->get_container_size());
-  std::stringstream infStrS;
-  infStrS.precision(3);
-  infStrS << fixed << "day " << day << " dis " << this->disease->get_disease_name() << " host " << this->host->get_id()
-	        << " age " << this->host->get_real_age()
-	        << " | DATES exp " << this->exposure_date
-	        << " inf " << get_infectious_start_date() << " " << get_infectious_end_date()
-	        << " symp " << get_symptoms_start_date() << " " << get_symptoms_end_date()
-	        << " rec " << get_infectious_end_date() << " sus " << get_immunity_end_date()
-	        << " infector_exp_date " << (this->infector == NULL ? -1 : this->infector->get_exposure_date(this->disease->get_id()))
-	        << " | ";
 
   if(Global::Track_infection_events > 1) {
-    infStrS << " sick_leave " << this->host->is_sick_leave_available()
-	          << " infector " << (this->infector == NULL ? -1 : this->infector->get_id()) << " inf_age "
-	          << (this->infector == NULL ? -1 : this->infector->get_real_age()) << " inf_sympt "
-	          << (this->infector == NULL ? -1 : this->infector->is_symptomatic()) << " inf_sick_leave "
-	          << (this->infector == NULL ? -1 : this->infector->is_sick_leave_available())
-	    << " at " << mixing_group_type << " mixing_group " <<  mixing_group_id << " subtype " << mixing_group_subtype << " mixing_group_lbl " << mixing_group_label;
-    infStrS << " size " << mixing_group_size << " is_teacher " << (int)this->host->is_teacher() << " is_student " << (int)this->host->is_student() << " total_infections " << (int)this->host->get_total_number_of_infections();
-    int income_mixing_group = -1;
-    string host_classroom_label =  (this->host->get_classroom() == NULL ? "NA" : Place::get_place_label(this->host->get_classroom()));
-    string host_school_label = (this->host->get_school() == NULL ? "NA" : Place::get_place_label(this->host->get_school()));
+    event.host_sick_leave = this->host->is_sick_leave_available();
+    if(this->infector != NULL) {
+      event.infector_age = this->infector->get_real_age();
+      event.infector_symptomatic = this->infector->is_symptomatic();
+      event.infector_sick_leave = this->infector->is_sick_leave_available();
+    }
+    event.is_teacher = (int)this->host->is_teacher();
+    event.is_student = (int)this->host->is_student();
+    event.total_infections = (int)this->host->get_total_number_of_infections();
+    if(this->host->get_classroom() != NULL) {
+      event_log_copy_label(event.classroom_label, Place::get_place_label(this->host->get_classroom()));
+    }
+    if(this->host->get_school() != NULL) {
+      event_log_copy_label(event.school_label, Place::get_place_label(this->host->get_school()));
+    }
     // if mixing_group is classroom, print out details
-    if(mixing_group_type == 'S' || mixing_group_type == 'C'){
+    if(event.mixing_group_type == 'S' || event.mixing_group_type == 'C'){
       School* ss = static_cast<School*>(this->mixing_group);
-      income_mixing_group = ss->get_school_income();
+      event.income = ss->get_school_income();
       int sch_census_tract_index = (ss == NULL ? -1 : ss->get_census_tract_index());
-      long int sch_census_tract = (sch_census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(sch_census_tract_index));
-      infStrS << " sch_census_tract " << sch_census_tract;
-    }else{
-      infStrS << " sch_census_tract -1 ";
+      event.school_census_tract = (sch_census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(sch_census_tract_index));
     }
-    infStrS << " income " << income_mixing_group;
-    infStrS << " classroom_lbl " << host_classroom_label;
-    infStrS << " school_lbl " << host_school_label;    
   }
 
   if(Global::Track_infection_events > 2) {
-    if(mixing_group_type != 'X'  && this->infector != NULL) {
+    if(event.mixing_group_type != 'X'  && this->infector != NULL) {
       double host_x = this->host->get_x();
       double host_y = this->host->get_y();
       double infector_x = this->infector->get_x();
       double infector_y = this->infector->get_y();
-      double distance = sqrt((host_x - infector_x) * (host_x - infector_x) + (host_y - infector_y) * (host_y - infector_y));
-      infStrS << " dist " << distance;
-    } else {
-      infStrS << " dist -1 ";
+      event.distance = sqrt((host_x - infector_x) * (host_x - infector_x) + (host_y - infector_y) * (host_y - infector_y));
     }
     //Add Census Tract information. If there was no infector, censustract is -1
-    if(this->infector == NULL) {
-      infStrS << " infctr_census_tract -1";
-      infStrS << " host_census_tract -1";
-    } else {
+    if(this->infector != NULL) {
       Household* hh = static_cast<Household*>(this->infector->get_household());
       if(hh == NULL) {
         if(Global::Enable_Hospitals && this->infector->is_hospitalized() && this->infector->get_permanent_household() != NULL) {
@@ -386,8 +384,7 @@ void Infection::report_infection(int day) {
         }
       }
       int census_tract_index = (hh == NULL ? -1 : hh->get_census_tract_index());
-      long int census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
-      infStrS << " infctr_census_tract " << census_tract;
+      event.infector_census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
 
       hh = static_cast<Household*>(this->host->get_household());
       if(hh == NULL) {
@@ -396,46 +393,61 @@ void Infection::report_infection(int day) {
         }
       }
       census_tract_index = (hh == NULL ? -1 : hh->get_census_tract_index());
-      census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
-      infStrS << " host_census_tract " << census_tract;      
+      event.host_census_tract = (census_tract_index == -1 ? -1 : Global::Places.get_census_tract_with_index(census_tract_index));
     }
-    infStrS << " | ";
-    if(dynamic_cast<Place*>(this->mixing_group) != NULL) {
-      Place* place = dynamic_cast<Place*>(this->mixing_group);
-      if(mixing_group_type != 'X') {
-        fred::geo lat = place->get_latitude();
-        fred::geo lon = place->get_longitude();
-        infStrS << " lat " << lat;
-        infStrS << " lon " << lon;
-      } else {
-        infStrS << " lat " << -999;
-        infStrS << " lon " << -999;
+    if(place != NULL) {
+      if(event.mixing_group_type != 'X') {
+        event.lat = place->get_latitude();
+        event.lon = place->get_longitude();
       }
-      double host_lat = this->host->get_household()->get_latitude();
-      double host_lon = this->host->get_household()->get_longitude();
-      string home_id(this->host->get_household()->get_label());
-      string inf_home_id(this->infector == NULL ? "H-1" : this->infector->get_household()->get_label());
-      infStrS << " home_lat " << host_lat;
-      infStrS << " home_lon " << host_lon;
-      infStrS << " home_host_id " << home_id;
-      infStrS << " home_inf_id " << inf_home_id;
-      infStrS << " | ";
-    }    
+      event.home_lat = this->host->get_household()->get_latitude();
+      event.home_lon = this->host->get_household()->get_longitude();
+      event_log_copy_label(event.home_label, this->host->get_household()->get_label());
+      event_log_copy_label(event.infector_home_label,
+			   this->infector == NULL ? "H-1" : this->infector->get_household()->get_label());
+    }
   }
   if(Global::Track_infection_events > 3){
     Neighborhood_Patch* pt = this->host->get_household()->get_patch();
     if(pt != NULL){
-      double patch_lat = Geo::get_latitude(pt->get_center_y());
-      double patch_lon = Geo::get_longitude(pt->get_center_x());
-      int patch_pop = pt->get_popsize();
-      infStrS << " patch_lat " << patch_lat;
-      infStrS << " patch_lon " << patch_lon;
-      infStrS << " patch_pop " << patch_pop;
-      infStrS << " | ";
+      event.has_patch = true;
+      event.patch_lat = Geo::get_latitude(pt->get_center_y());
+      event.patch_lon = Geo::get_longitude(pt->get_center_x());
+      event.patch_pop = pt->get_popsize();
     }
   }
-  infStrS << "\n";
-  fprintf(Global::Infectionfp, "%s", infStrS.str().c_str());  
+
+  if(Global::Infection_log != NULL) {
+    Global::Infection_log->append(&event);
+  } else {
+    std::stringstream infStrS;
+    event.print(infStrS, Global::Track_infection_events, this->disease->get_disease_name());
+    fprintf(Global::Infectionfp, "%s", infStrS.str().c_str());
+  }
+}
+
+void Infection::report_case_fatality(int day) {
+  if(Global::Track_fatality_events == false || (Global::InfectionCFfp == NULL && Global::InfectionCF_log == NULL)) {
+    return;
+  }
+  Fatality_Event event;
+  memset(&event, 0, sizeof(event));
+  event.day = day;
+  event.disease_id = this->disease->get_id();
+  event.host_id = this->host->get_id();
+  event.host_age = this->host->get_real_age();
+  event.exposure_date = this->exposure_date;
+  event.infectious_start_date = get_infectious_start_date();
+  event.infectious_end_date = get_infectious_end_date();
+  event.symptoms_start_date = get_symptoms_start_date();
+  event.symptoms_end_date = get_symptoms_end_date();
+  if(Global::InfectionCF_log != NULL) {
+    Global::InfectionCF_log->append(&event);
+  } else {
+    std::stringstream infCFStrS;
+    event.print(infCFStrS, this->disease->get_disease_name());
+    fprintf(Global::InfectionCFfp, "%s", infCFStrS.str().c_str());
+  }
 }
 
 void Infection::update(int today) {
@@ -447,38 +459,14 @@ void Infection::update(int today) {
       if(this->disease->is_fatal(this->host, get_symptoms(today), days_symptomatic)) {	
 	set_fatal_infection();
 	// If CF report is enabled, then print stats on case fatalities
-	if(Global::Track_fatality_events == true && Global::InfectionCFfp != NULL ){	      
-	  std::stringstream infCFStrS;
-	  infCFStrS.precision(3);
-	  
-	  infCFStrS << fixed << "day " << today << " dis " << this->disease->get_disease_name() << " host " << this->host->get_id()
-		    << " age " << this->host->get_real_age()
-		    << " | DATES exp " << this->exposure_date
-		    << " inf " << get_infectious_start_date() << " " << get_infectious_end_date()
-		    << " symp " << get_symptoms_start_date() << " " << get_symptoms_end_date()
-		    << " dead " << today;
-	  infCFStrS << "\n";
-	  fprintf(Global::InfectionCFfp, "%s", infCFStrS.str().c_str()); 
-	}
+	report_case_fatality(today);
       }
     } else {
       if(this->disease->is_fatal(this->host->get_real_age(), get_symptoms(today), days_symptomatic)) {
 	set_fatal_infection();
 	
 	// If CF report is enabled, then print stats on case fatalities
-	if(Global::Track_fatality_events == true && Global::InfectionCFfp != NULL ){	      
-	  std::stringstream infCFStrS;
-	  infCFStrS.precision(3);
-	  
-	  infCFStrS << fixed << "day " << today << " dis " << this->disease->get_disease_name() << " host " << this->host->get_id()
-		    << " age " << this->host->get_real_age()
-		    << " | DATES exp " << this->exposure_date
-		    << " inf " << get_infectious_start_date() << " " << get_infectious_end_date()
-		    << " symp " << get_symptoms_start_date() << " " << get_symptoms_end_date()
-		    << " dead " << today;
-	  infCFStrS << "\n";
-	  fprintf(Global::InfectionCFfp, "%s", infCFStrS.str().c_str()); 
-	}
+	report_case_fatality(today);
       }
     }
   }
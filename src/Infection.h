@@ -64,6 +64,12 @@ public:
 
   virtual void report_infection(int day);
 
+  /**
+   * Write a case fatality event to the infectionsCF file or binary log
+   * @param day the day of death
+   */
+  void report_case_fatality(int day);
+
   // methods for antivirals
   virtual bool provides_immunity() {
     return true;
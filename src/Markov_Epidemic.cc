@@ -65,7 +65,8 @@ void Markov_Epidemic::prepare() {
 
   // initialize the population
   int day = 0;
-  int popsize = Global::Pop.get_pop_size();
+  // the initial states are drawn in index order, so that they do not
+  // depend on the number of threads
   for(int p = 0; p < Global::Pop.get_index_size(); ++p) {
     Person* person = Global::Pop.get_person_by_index(p);
     if(person == NULL) {
@@ -103,6 +103,83 @@ void Markov_Model::get_parameters() {
       this->transition_matrix[group][i][i] = 1.0 - sum;
     }
   }
+
+  compile();
+}
+
+
+void Markov_Model::compile() {
+  int n = this->number_of_states;
+  this->initial_state_table.resize(this->age_groups);
+  this->exit_rate.assign(this->age_groups * n, 0.0);
+  this->destination_table.resize(this->age_groups * n);
+  std::vector<double> weights(n);
+  for (int group = 0; group < this->age_groups; group++) {
+    for (int i = 0; i < n; i++) {
+      weights[i] = this->state_initial_percent[group][i];
+    }
+    build_alias_table(weights, this->initial_state_table[group]);
+
+    for (int i = 0; i < n; i++) {
+      double total = 0.0;
+      for (int j = 0; j < n; j++) {
+	weights[j] = (i == j ? 0.0 : this->transition_matrix[group][i][j]);
+	total += weights[j];
+      }
+      this->exit_rate[group * n + i] = total;
+      if (total > 0.0) {
+	build_alias_table(weights, this->destination_table[group * n + i]);
+      }
+    }
+  }
+}
+
+
+void Markov_Model::build_alias_table(const std::vector<double> &weights, Alias_Table &table) {
+  int n = weights.size();
+  double total = 0.0;
+  for (int i = 0; i < n; i++) {
+    total += weights[i];
+  }
+  assert(total > 0.0);
+  table.prob.assign(n, 1.0);
+  table.alias.resize(n);
+  std::vector<int> small;
+  std::vector<int> large;
+  std::vector<double> scaled(n);
+  for (int i = 0; i < n; i++) {
+    table.alias[i] = i;
+    scaled[i] = weights[i] * n / total;
+    if (scaled[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+  while (!small.empty() && !large.empty()) {
+    int s = small.back();
+    small.pop_back();
+    int l = large.back();
+    table.prob[s] = scaled[s];
+    table.alias[s] = l;
+    scaled[l] -= 1.0 - scaled[s];
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // anything left over is 1.0 up to rounding error
+}
+
+
+int Markov_Model::draw_from_alias_table(const Alias_Table &table) {
+  int n = table.prob.size();
+  double r = n * Random::draw_random();
+  int i = (int) r;
+  if (i >= n) {
+    i = n - 1;
+  }
+  return (r - i < table.prob[i] ? i : table.alias[i]);
 }
 
 
@@ -129,38 +206,21 @@ void Markov_Model::print() {
 
 
 int Markov_Model::get_initial_state(double age) {
-  int group = this->age_map->find_value(age);
-  double r = 100.0 * Random::draw_random();
-  double sum = 0.0;
-  for (int i = 0; i < this->number_of_states; i++) {
-    sum += this->state_initial_percent[group][i];
-    if (r < sum) {
-      return i;
-    }
-  }  
-  assert(r < sum);
-  return -1;
+  int group = get_age_group(age);
+  return draw_from_alias_table(this->initial_state_table[group]);
 }
 
 
 void Markov_Model::get_next_state_and_time(int day, double age, int old_state, int* new_state, int* transition_day) {
-  *transition_day = -1;
-  *new_state = old_state;
-  int group = this->age_map->find_value(age);
-  for (int j = 0; j < this->number_of_states; j++) {
-    if (j == old_state) {
-      continue;
-    }
-    double lambda = this->transition_matrix[group][old_state][j];
-    if (lambda == 0.0) {
-      continue;
-    }
-    int t = day + 1 + round(Random::draw_exponential(lambda) * this->period_in_transition_probabilities);
-    if (*transition_day < 0 || t < *transition_day) {
-      *transition_day = t;
-      *new_state = j;
-    }
+  int k = get_age_group(age) * this->number_of_states + old_state;
+  double rate = this->exit_rate[k];
+  if (rate == 0.0) {
+    *transition_day = -1;
+    *new_state = old_state;
+    return;
   }
+  *transition_day = day + 1 + round(Random::draw_exponential(rate) * this->period_in_transition_probabilities);
+  *new_state = draw_from_alias_table(this->destination_table[k]);
 }
 
 
@@ -13,6 +13,7 @@
 #define _FRED_MARKOV_MODEL_H
 
 #include <string>
+#include <vector>
 using namespace std;
 
 class Age_Map;
@@ -47,6 +48,17 @@ public:
 
   int get_initial_state(double age);
 
+  /**
+   * Sample the next transition out of old_state.  The competing
+   * exponential waiting times are sampled as one waiting time at the total
+   * exit rate, followed by the destination drawn in proportion to the rates.
+   *
+   * @param day the current day
+   * @param age the age of the agent
+   * @param old_state the current state
+   * @param new_state set to the next state (old_state if there is no exit)
+   * @param transition_day set to the day of the transition (-1 if none)
+   */
   void get_next_state_and_time(int day, double age, int old_state, int* new_state, int* transition_day);
 
   int get_age_group(double age);
@@ -57,11 +69,26 @@ protected:
   std::vector<std::string>state_name;
 
 private:
+  // Walker alias table for drawing from a discrete distribution in constant time
+  struct Alias_Table {
+    std::vector<double> prob;
+    std::vector<int> alias;
+  };
+
+  void compile();
+  static void build_alias_table(const std::vector<double> &weights, Alias_Table &table);
+  static int draw_from_alias_table(const Alias_Table &table);
+
   Age_Map* age_map;
   int age_groups;
   double** state_initial_percent;
   double*** transition_matrix;
   int period_in_transition_probabilities;
+
+  // compiled tables, indexed by group * number_of_states + state
+  std::vector<Alias_Table> initial_state_table;  // indexed by group
+  std::vector<double> exit_rate;
+  std::vector<Alias_Table> destination_table;
 };
 
 #endif
@@ -442,30 +442,7 @@ bool Natural_History::is_fatal(Person* per, double symptoms, int days_symptomati
     if(per->has_chronic_condition()) {
       double age_prob = this->age_specific_prob_case_fatality->find_value(per->get_real_age());
       double day_prob = this->case_fatality_prob_by_day[days_symptomatic];
-      if(per->is_asthmatic()) {
-        age_prob *= Health::get_chronic_condition_case_fatality_prob_mult(per->get_age(), Chronic_condition_index::ASTHMA);
-      }
-      if(per->has_COPD()) {
-        age_prob *= Health::get_chronic_condition_case_fatality_prob_mult(per->get_age(), Chronic_condition_index::COPD);
-      }
-      if(per->has_chronic_renal_disease()) {
-        age_prob *= Health::get_chronic_condition_case_fatality_prob_mult(per->get_age(), Chronic_condition_index::CHRONIC_RENAL_DISEASE);
-      }
-      if(per->is_diabetic()) {
-        age_prob *= Health::get_chronic_condition_case_fatality_prob_mult(per->get_age(), Chronic_condition_index::DIABETES);
-      }
-      if(per->has_heart_disease()) {
-        age_prob *= Health::get_chronic_condition_case_fatality_prob_mult(per->get_age(), Chronic_condition_index::HEART_DISEASE);
-      }
-      if(per->has_hypertension()) {
-        age_prob *= Health::get_chronic_condition_case_fatality_prob_mult(per->get_age(), Chronic_condition_index::HYPERTENSION);
-      }
-      if(per->has_hypercholestrolemia()) {
-        age_prob *= Health::get_chronic_condition_case_fatality_prob_mult(per->get_age(), Chronic_condition_index::HYPERCHOLESTROLEMIA);
-      }
-      if(per->get_demographics()->is_pregnant()) {
-        age_prob *= Health::get_pregnancy_case_fatality_prob_mult(per->get_age());
-      }
+      age_prob *= per->get_health()->get_chronic_condition_case_fatality_mult();
       return (Random::draw_random() < age_prob * day_prob);
     } else {
       return is_fatal(per->get_age(), symptoms, days_symptomatic);
@@ -14,6 +14,10 @@
 // File: Network.cc
 //
 
+#include <cmath>
+#include <cstring>
+#include <random>
+
 #include "Network.h"
 #include "Global.h"
 #include "Params.h"
@@ -307,3 +311,246 @@ void Network::create_random_network(double mean_degree) {
     }
   }
 }
+
+void Network::set_links(const std::vector<int> &src, const std::vector<int> &dst) {
+  int size = this->get_size();
+  int number_edges = src.size();
+  assert(dst.size() == src.size());
+
+  // bucket the edges by source (stable, so each out-list keeps the input order)
+  std::vector<int> offset(size + 1, 0);
+  for(int e = 0; e < number_edges; ++e) {
+    assert(0 <= src[e] && src[e] < size && 0 <= dst[e] && dst[e] < size);
+    offset[src[e] + 1]++;
+  }
+  for(int i = 0; i < size; ++i) {
+    offset[i + 1] += offset[i];
+  }
+  std::vector<int> target(number_edges);
+  std::vector<int> next(offset.begin(), offset.end() - 1);
+  for(int e = 0; e < number_edges; ++e) {
+    target[next[src[e]]++] = dst[e];
+  }
+
+  // drop self-loops and duplicates in place, counting in-degrees
+  std::vector<int> last_source(size, -1);
+  std::vector<int> in_offset(size + 1, 0);
+  int kept = 0;
+  int begin = 0;
+  for(int i = 0; i < size; ++i) {
+    int end = offset[i + 1];
+    offset[i] = kept;
+    for(int k = begin; k < end; ++k) {
+      int j = target[k];
+      if(j != i && last_source[j] != i) {
+        last_source[j] = i;
+        target[kept++] = j;
+        in_offset[j + 1]++;
+      }
+    }
+    begin = end;
+  }
+  offset[size] = kept;
+
+  // in-links, in order of source
+  for(int i = 0; i < size; ++i) {
+    in_offset[i + 1] += in_offset[i];
+  }
+  std::vector<int> source(kept);
+  next.assign(in_offset.begin(), in_offset.end() - 1);
+  for(int i = 0; i < size; ++i) {
+    for(int k = offset[i]; k < offset[i + 1]; ++k) {
+      source[next[target[k]]++] = i;
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic,1024)
+  for(int i = 0; i < size; ++i) {
+    Person_Network_Link* link = this->get_enrollee(i)->get_network_link(this);
+    std::vector<Person*> people;
+    people.reserve(offset[i + 1] - offset[i]);
+    for(int k = offset[i]; k < offset[i + 1]; ++k) {
+      people.push_back(this->get_enrollee(target[k]));
+    }
+    link->set_links_to(people);
+    people.clear();
+    for(int k = in_offset[i]; k < in_offset[i + 1]; ++k) {
+      people.push_back(this->get_enrollee(source[k]));
+    }
+    link->set_links_from(people);
+  }
+}
+
+unsigned long Network::draw_generator_seed() {
+  return static_cast<unsigned long>(Random::draw_random() * 4294967296.0);
+}
+
+void Network::create_erdos_renyi_network(double p) {
+  std::vector<int> block(this->get_size(), 0);
+  std::vector< std::vector<double> > prob(1, std::vector<double>(1, p));
+  create_stochastic_block_network(block, prob);
+}
+
+void Network::create_configuration_model_network(const std::vector<int> &degree) {
+  int size = this->get_size();
+  assert(static_cast<int>(degree.size()) == size);
+  std::vector<int> src;
+  for(int i = 0; i < size; ++i) {
+    src.insert(src.end(), degree[i], i);
+  }
+  // match the out-stubs with a random permutation of the in-stubs
+  std::vector<int> dst(src);
+  std::mt19937_64 rng(Network::draw_generator_seed());
+  for(int k = static_cast<int>(dst.size()) - 1; k > 0; --k) {
+    int r = std::uniform_int_distribution<int>(0, k)(rng);
+    std::swap(dst[k], dst[r]);
+  }
+  FRED_VERBOSE(0, "%s configuration model: size = %d  stubs = %d\n", get_label(), size, (int)src.size());
+  set_links(src, dst);
+}
+
+void Network::create_stochastic_block_network(const std::vector<int> &block, const std::vector< std::vector<double> > &prob) {
+  int size = this->get_size();
+  int number_of_blocks = prob.size();
+  assert(static_cast<int>(block.size()) == size);
+  std::vector< std::vector<int> > members(number_of_blocks);
+  for(int i = 0; i < size; ++i) {
+    assert(0 <= block[i] && block[i] < number_of_blocks);
+    members[block[i]].push_back(i);
+  }
+
+  unsigned long seed = Network::draw_generator_seed();
+  int chunks = (size + GENERATOR_CHUNK_SIZE - 1) / GENERATOR_CHUNK_SIZE;
+  std::vector< std::vector<int> > chunk_src(chunks);
+  std::vector< std::vector<int> > chunk_dst(chunks);
+
+#pragma omp parallel for schedule(dynamic,1)
+  for(int c = 0; c < chunks; ++c) {
+    std::mt19937_64 rng(seed * 1000003ul + c);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    int end = std::min(size, (c + 1) * GENERATOR_CHUNK_SIZE);
+    for(int i = c * GENERATOR_CHUNK_SIZE; i < end; ++i) {
+      for(int b = 0; b < number_of_blocks; ++b) {
+        double p = prob[block[i]][b];
+        int n = members[b].size();
+        if(p <= 0.0 || n == 0) {
+          continue;
+        }
+        // skip a geometric number of non-links between successive links;
+        // the self-loop, if drawn, is dropped by set_links
+        double log_q = (p < 1.0 ? log(1.0 - p) : 0.0);
+        double k = -1;
+        while(true) {
+          if(p < 1.0) {
+            k += 1 + floor(log(1.0 - uniform(rng)) / log_q);
+          } else {
+            k += 1;
+          }
+          if(k >= n) {
+            break;
+          }
+          chunk_src[c].push_back(i);
+          chunk_dst[c].push_back(members[b][static_cast<int>(k)]);
+        }
+      }
+    }
+  }
+
+  std::vector<int> src;
+  std::vector<int> dst;
+  for(int c = 0; c < chunks; ++c) {
+    src.insert(src.end(), chunk_src[c].begin(), chunk_src[c].end());
+    dst.insert(dst.end(), chunk_dst[c].begin(), chunk_dst[c].end());
+  }
+  FRED_VERBOSE(0, "%s stochastic block model: size = %d  blocks = %d  edges = %d\n",
+               get_label(), size, number_of_blocks, (int)src.size());
+  set_links(src, dst);
+}
+
+bool Network::write_edge_file(const char* filename) {
+  FILE* fp = fopen(filename, "wb");
+  if(fp == NULL) {
+    return false;
+  }
+  int size = this->get_size();
+  Edge_File_Header header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header.magic, EDGE_FILE_MAGIC(), sizeof(header.magic));
+  header.number_of_nodes = size;
+  header.number_of_edges = 0;
+  for(int i = 0; i < size; ++i) {
+    header.number_of_edges += this->get_enrollee(i)->get_out_degree(this);
+  }
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+  // (source id, destination id) pairs, grouped by source
+  std::vector<int32_t> buffer;
+  for(int i = 0; ok && i < size; ++i) {
+    Person* person = this->get_enrollee(i);
+    const std::vector<Person*> &links = person->get_network_link(this)->get_links_to();
+    for(int k = 0; k < static_cast<int>(links.size()); ++k) {
+      buffer.push_back(person->get_id());
+      buffer.push_back(links[k]->get_id());
+    }
+    if(buffer.size() >= (1 << 20) || i == size - 1) {
+      ok = buffer.empty() || fwrite(&buffer[0], sizeof(int32_t), buffer.size(), fp) == buffer.size();
+      buffer.clear();
+    }
+  }
+  return (fclose(fp) == 0) && ok;
+}
+
+bool Network::read_edge_file(const char* filename) {
+  FILE* fp = fopen(filename, "rb");
+  if(fp == NULL) {
+    return false;
+  }
+  Edge_File_Header header;
+  if(fread(&header, sizeof(header), 1, fp) != 1
+     || strncmp(header.magic, EDGE_FILE_MAGIC(), sizeof(header.magic)) != 0) {
+    fclose(fp);
+    return false;
+  }
+
+  // map person ids to enrollee indices
+  int size = this->get_size();
+  int max_id = -1;
+  for(int i = 0; i < size; ++i) {
+    max_id = std::max(max_id, this->get_enrollee(i)->get_id());
+  }
+  std::vector<int> index_of_id(max_id + 1, -1);
+  for(int i = 0; i < size; ++i) {
+    index_of_id[this->get_enrollee(i)->get_id()] = i;
+  }
+
+  std::vector<int> src;
+  std::vector<int> dst;
+  src.reserve(header.number_of_edges);
+  dst.reserve(header.number_of_edges);
+  std::vector<int32_t> buffer(1 << 20);
+  uint64_t remaining = 2 * header.number_of_edges;
+  int dropped = 0;
+  while(remaining > 0) {
+    size_t n = std::min(remaining, static_cast<uint64_t>(buffer.size()));
+    if(fread(&buffer[0], sizeof(int32_t), n, fp) != n) {
+      fclose(fp);
+      return false;
+    }
+    for(size_t k = 0; k + 1 < n; k += 2) {
+      int from = buffer[k];
+      int to = buffer[k + 1];
+      if(0 <= from && from <= max_id && 0 <= to && to <= max_id
+         && index_of_id[from] >= 0 && index_of_id[to] >= 0) {
+        src.push_back(index_of_id[from]);
+        dst.push_back(index_of_id[to]);
+      } else {
+        dropped++;
+      }
+    }
+    remaining -= n;
+  }
+  fclose(fp);
+  FRED_VERBOSE(0, "%s read %d edges from %s, dropped %d\n", get_label(), (int)src.size(), filename, dropped);
+  set_links(src, dst);
+  return true;
+}
@@ -17,6 +17,8 @@
 #ifndef _FRED_NETWORK_H
 #define _FRED_NETWORK_H
 
+#include <vector>
+
 #include "Mixing_Group.h"
 class Disease;
 
@@ -69,9 +71,75 @@ public:
   double get_mean_degree();
   void test();
   void create_random_network(double mean_degree);
+
+  /**
+   * Replace all links in the network with the given directed edges, using
+   * a compressed sparse row build instead of adding links one at a time.
+   * Self-loops and duplicate edges are dropped.
+   *
+   * @param src the enrollee index of the source of each edge
+   * @param dst the enrollee index of the destination of each edge
+   */
+  void set_links(const std::vector<int> &src, const std::vector<int> &dst);
+
+  // Generators.  Each replaces all links in the network.  Rows of the
+  // adjacency matrix are generated in fixed-size chunks, each with its own
+  // random number stream seeded from Random, so a run gives the same
+  // network whatever the number of threads.
+
+  /**
+   * Directed G(n,p): each ordered pair of distinct enrollees is linked with
+   * probability p.  Uses geometric skips, so the work is O(n + edges).
+   */
+  void create_erdos_renyi_network(double p);
+
+  /**
+   * Directed configuration model: enrollee i gets degree[i] out-stubs and
+   * degree[i] in-stubs, which are matched at random.  Self-loops and
+   * duplicate edges are dropped.
+   *
+   * @param degree the degree of each enrollee, in enrollee order
+   */
+  void create_configuration_model_network(const std::vector<int> &degree);
+
+  /**
+   * Directed stochastic block model: an enrollee in block a is linked to
+   * each enrollee in block b with probability prob[a][b].
+   *
+   * @param block the block of each enrollee, in enrollee order
+   * @param prob the link probability between each pair of blocks
+   */
+  void create_stochastic_block_network(const std::vector<int> &block, const std::vector< std::vector<double> > &prob);
+
+  /**
+   * Write the links as a binary edge file of person ids
+   * @return false if the file can not be written
+   */
+  bool write_edge_file(const char* filename);
+
+  /**
+   * Replace the links with those in a binary edge file.  Edges to people
+   * who are not enrolled in the network are dropped.
+   * @return false if the file can not be read
+   */
+  bool read_edge_file(const char* filename);
   void infect_random_nodes(double pct, Disease* disease);
 
 private:
+  static const int GENERATOR_CHUNK_SIZE = 4096;
+
+  struct Edge_File_Header {
+    char magic[16];
+    uint64_t number_of_nodes;
+    uint64_t number_of_edges;
+  };
+
+  static const char* EDGE_FILE_MAGIC() {
+    return "FRED EDGES v01";
+  }
+
+  static unsigned long draw_generator_seed();
+
   static double contacts_per_day;
   static double** prob_transmission_per_contact;
 };
@@ -25,11 +25,8 @@
 
 //  ...Constructors and Destructors...
 
-void *ODE::cvode_mem_;
-bool ODE::CVode_created_;
-
-
 ODE::ODE(int numStrains) {
+  cvode_mem_ = NULL;
   set_num_strains(numStrains);
   set_num_equations(numStrains * 5 + 5);
   set_duration(8);
@@ -74,7 +71,9 @@ void ODE::setup() {
 ODE::~ODE() {
   N_VDestroy_Serial(initial_conditions);
   N_VDestroy_Serial(absolute_tolerance);
-  CVodeFree(&cvode_mem_);
+  if (cvode_mem_ != NULL) {
+    CVodeFree(&cvode_mem_);
+  }
   clear();
 }
 
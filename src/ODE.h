@@ -222,9 +222,9 @@ public:
 
 private:
   std::map<double, N_Vector> results;
-  static void *cvode_mem_;
+  // each instance owns its solver, so separate instances can be solved concurrently
+  void *cvode_mem_;
   double *initial_values_;
-  static bool CVode_created_;
   // Problem Constants...
   int num_equations;
   int num_strains;
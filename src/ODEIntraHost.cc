@@ -15,10 +15,14 @@
 #include "ODE.h"
 #include "Random.h"
 #include "Params.h"
+#include <cmath>
 #include <map>
 
 using namespace std;
 
+// spacing of the inoculum grid on which ODE solutions are cached
+static const double INOCULUM_GRID_STEP = 0.001;
+
 void ODEIntraHost::setup(Disease *disease) {
   IntraHost::setup(disease);
   get_param((char *) "viral_titer_scaling", & viral_titer_scaling);
@@ -68,55 +72,109 @@ vector<double> ODEIntraHost::get_symptomaticity(double *interferon, int duration
   return symptomaticity;
 }
 
-Trajectory *ODEIntraHost :: get_trajectory() {
-  /*  if(! initialized){
-      initialize();
-      initialized = true;
-      }
-  */
-  int numStrains = loads->size();
-  ODE *ebm = new ODE(numStrains);
+ODEIntraHost::~ODEIntraHost() {
+  for(map< vector<int>, ODE_Solution* >::iterator it = solutions.begin(); it != solutions.end(); ++it) {
+    delete it->second;
+  }
+  solutions.clear();
+}
 
-  // set indices to strains
-  int indices[numStrains];
+const ODEIntraHost::ODE_Solution* ODEIntraHost::get_solution(const vector<int> &grid_point) {
+  fred::Scoped_Lock lock(solutions_mutex);
+  map< vector<int>, ODE_Solution* >::iterator found = solutions.find(grid_point);
+  if(found != solutions.end()) {
+    return found->second;
+  }
+  lock.Unlock();
+
+  // solve outside the lock; each thread uses its own solver
+  int numStrains = grid_point.size();
+  ODE ebm(numStrains);
+  for(int s = 0; s < numStrains; s++) {
+    ebm.set_V(grid_point[s] * INOCULUM_GRID_STEP, s);
+  }
+  ebm.setup();
+
+  ODE_Solution *solution = new ODE_Solution;
+  solution->duration = ebm.get_duration();
+  for(int s = 0; s < numStrains; s++) {
+    double *vt = ebm.get_viral_titer_data(s);
+    solution->viral_titer.push_back(vector<double>(vt, vt + solution->duration));
+    delete[] vt;
+  }
+  double *ft = ebm.get_interferon_data();
+  solution->interferon.assign(ft, ft + solution->duration);
+  delete[] ft;
+
+  lock.LockAgain();
+  // another thread may have solved the same grid point in the meantime
+  pair< map< vector<int>, ODE_Solution* >::iterator, bool > inserted =
+    solutions.insert(make_pair(grid_point, solution));
+  if(!inserted.second) {
+    delete solution;
+  }
+  return inserted.first->second;
+}
 
-  Loads* loads;
-  loads = new Loads;
-  loads->clear();
-  loads->insert( pair<int, double> (1, 1.0) );
+void ODEIntraHost::get_interpolated_solution(const vector<double> &inoculum, ODE_Solution &solution) {
+  int numStrains = inoculum.size();
+  vector<int> grid_point(numStrains);
+  vector<double> position(numStrains);
+  for(int s = 0; s < numStrains; s++) {
+    position[s] = max(0.0, inoculum[s]) / INOCULUM_GRID_STEP;
+    grid_point[s] = (int) floor(position[s]);
+  }
 
-  Trajectory * trajectory = new Trajectory();
+  if(numStrains != 1) {
+    // use the nearest grid point when several strains are present
+    for(int s = 0; s < numStrains; s++) {
+      grid_point[s] = (int) floor(position[s] + 0.5);
+    }
+    solution = *get_solution(grid_point);
+    return;
+  }
 
-  map<int, double> :: iterator it = loads->begin();
+  // interpolate linearly between the two neighbouring grid points
+  double weight = position[0] - grid_point[0];
+  const ODE_Solution *lower = get_solution(grid_point);
+  grid_point[0]++;
+  const ODE_Solution *upper = get_solution(grid_point);
 
-  for(int s = 0; s < numStrains; s++, it++) {
-    indices[s] = it->first;
-    double inoculum_particles = get_inoculum_particles(it->second);
-    ebm->set_V(inoculum_particles, s);
+  solution = *lower;
+  for(int day = 0; day < solution.duration; day++) {
+    solution.viral_titer[0][day] += weight * (upper->viral_titer[0][day] - lower->viral_titer[0][day]);
+    solution.interferon[day] += weight * (upper->interferon[day] - lower->interferon[day]);
   }
+}
 
-  // TODO set reqd params
+Trajectory *ODEIntraHost :: get_trajectory() {
+  int numStrains = loads->size();
+
+  // set indices to strains
+  vector<int> indices;
+  vector<double> inoculum;
+  for(map<int, double> :: iterator it = loads->begin(); it != loads->end(); it++) {
+    indices.push_back(it->first);
+    inoculum.push_back(get_inoculum_particles(it->second));
+  }
 
+  // TODO set reqd params
 
-  // Use ODE
-  ebm->setup();
+  ODE_Solution solution;
+  get_interpolated_solution(inoculum, solution);
 
   Trajectory *trajectory = new Trajectory;
 
   // Infectivity Trajectories
-  for(int s = 0; s < numStrains; s++, it++) {
-    double *vt = ebm->get_viral_titer_data(s);
-    vector<double> it = getInfectivities(vt, ebm->get_duration());
+  for(int s = 0; s < numStrains; s++) {
+    vector<double> it = getInfectivities(&solution.viral_titer[s][0], solution.duration);
     it.insert(it.begin(), 0.0); // TODO
     trajectory->set_infectivity_trajectory(indices[s], it);
   }
 
   // Symptomaticity Trajectory
-  double *ft = ebm->get_interferon_data();
-  vector<double> st = get_symptomaticity(ft, ebm->get_duration());
+  vector<double> st = get_symptomaticity(&solution.interferon[0], solution.duration);
   trajectory->set_symptomaticity_trajectory(st);
 
-  delete ebm;
   return trajectory;
 }
-
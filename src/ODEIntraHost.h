@@ -20,6 +20,7 @@
 #include <map>
 #include <vector>
 
+#include "Global.h"
 #include "IntraHost.h"
 
 class Infection;
@@ -32,6 +33,7 @@ class ODEIntraHost : public IntraHost {
   // TODO set all initial values
 
 public:
+  ~ODEIntraHost();
   Trajectory* get_trajectory();
   void setup(Disease *disease);
   int get_days_symp() {
@@ -39,6 +41,20 @@ public:
   }
 
 private:
+  /*
+   * Daily viral titer (per strain) and interferon levels of one ODE
+   * solution.  Solutions are computed once per point of the inoculum grid
+   * and shared by every infection of the disease.
+   */
+  struct ODE_Solution {
+    int duration;
+    vector< vector<double> > viral_titer;
+    vector<double> interferon;
+  };
+
+  const ODE_Solution* get_solution(const vector<int> &grid_point);
+  void get_interpolated_solution(const vector<double> &inoculum, ODE_Solution &solution);
+
   double get_inoculum_particles (double infector_particles);
   vector<double> getInfectivities(double *viralTiter, int duration);
   vector<double> get_symptomaticity(double *interferon, int duration);
@@ -49,6 +65,10 @@ private:
   double viral_titer_latent_threshold;
   double interferon_scaling;
   double interferon_threshold;
+
+  // solutions keyed by the grid index of each strain's inoculum
+  map< vector<int>, ODE_Solution* > solutions;
+  fred::Mutex solutions_mutex;
 };
 
 
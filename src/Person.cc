@@ -26,6 +26,7 @@
 #include "Health.h"
 #include "Mixing_Group.h"
 #include "Place.h"
+#include "Place_List.h"
 #include "Population.h"
 #include "Random.h"
 
@@ -122,6 +123,9 @@ void Person::update_household_counts(int day, int disease_id) {
   }
   if(hh != NULL) {
     this->health.update_mixing_group_counts(day, disease_id, hh);
+    if(this->health.is_newly_infected(day, disease_id)) {
+      Global::Places.record_household_infection(disease_id);
+    }
   }
 }
 
@@ -199,22 +203,24 @@ Person* Person::give_birth(int day) {
 }
 
 string Person::to_string() {
+  string line;
+  append_to_string(line);
+  return line;
+}
 
-  stringstream tmp_string_stream;
+void Person::append_to_string(string &line) {
   // (i.e *ID* Age Sex Race Household School Classroom Workplace Office Neighborhood Hospital Ad_Hoc Relationship)
-  tmp_string_stream << this->id << " " << get_age() << " " <<  get_sex() << " " ;
-  tmp_string_stream << get_race() << " " ;
-  tmp_string_stream << Place::get_place_label(get_household()) << " ";
-  tmp_string_stream << Place::get_place_label(get_school()) << " ";
-  tmp_string_stream << Place::get_place_label(get_classroom()) << " ";
-  tmp_string_stream << Place::get_place_label(get_workplace()) << " ";
-  tmp_string_stream << Place::get_place_label(get_office()) << " ";
-  tmp_string_stream << Place::get_place_label(get_neighborhood()) << " ";
-  tmp_string_stream << Place::get_place_label(get_hospital()) << " ";
-  tmp_string_stream << Place::get_place_label(get_ad_hoc()) << " ";
-  tmp_string_stream << get_relationship();
-
-  return tmp_string_stream.str();
+  char buffer[64];
+  sprintf(buffer, "%d %d %c %d ", this->id, get_age(), get_sex(), get_race());
+  line += buffer;
+  Place* places[] = { get_household(), get_school(), get_classroom(), get_workplace(), get_office(),
+		      get_neighborhood(), get_hospital(), get_ad_hoc() };
+  for(int i = 0; i < (int)(sizeof(places) / sizeof(places[0])); ++i) {
+    line += Place::get_place_label(places[i]);
+    line += ' ';
+  }
+  sprintf(buffer, "%d", get_relationship());
+  line += buffer;
 }
 
 void Person::terminate(int day) {
@@ -117,8 +117,15 @@ public:
     return (this->health.get_vaccination_hosp_immunity_loss_day());
   }
   
-  void update_vaccine_interventions(int day) {
-    this->health.update_vaccine_interventions(day);
+  /**
+   * @param day the simulation day
+   * @param event the Vaccine_event due today
+   * @param record the position of the vaccination in the person's list
+   * @param vm the Vaccine_Manager that scheduled the event
+   * @see Health::process_vaccine_event(int day, int event, int record, Vaccine_Manager* vm)
+   */
+  void process_vaccine_event(int day, int event, int record, Vaccine_Manager* vm) {
+    this->health.process_vaccine_event(day, event, record, vm);
   }
 
   /**
@@ -157,6 +164,14 @@ public:
    */
   void update_activity_profile() {
     this->activities.update_profile();
+    this->activities.update_household_composition();
+  }
+
+  /**
+   * @Activities::update_household_composition()
+   */
+  void update_household_composition() {
+    this->activities.update_household_composition();
   }
 
   void become_susceptible(int disease_id) {
@@ -264,6 +279,13 @@ public:
    */
   string to_string();
 
+  /**
+   * Appends the to_string() representation of this Person to line, without
+   * building a separate string (see Population::write_population_output_file)
+   * @param line the string to append to
+   */
+  void append_to_string(string &line);
+
   // access functions:
   /**
    * The id is generated at runtime
@@ -816,6 +838,7 @@ public:
 
   void birthday(int day) {
     this->demographics.birthday(this, day);
+    this->activities.update_household_composition();
   }
 
   bool become_a_teacher(Place* school) {
@@ -1038,6 +1061,10 @@ public:
     return this->activities.get_end_of_link(n, network);
   }
 
+  Person_Network_Link* get_network_link(Network* network) {
+    return this->activities.get_network_link(network);
+  }
+
   int get_health_state(int disease_id) {
     return this->health.get_health_state(disease_id);
   }
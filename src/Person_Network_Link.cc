@@ -9,19 +9,132 @@
   more information.
 */
 
+#include <stdint.h>
+
 #include "Network.h"
 #include "Person.h"
 #include "Person_Network_Link.h"
 
+void Link_Index::build(const std::vector<Person*> &links) {
+  int capacity = 2 * LINK_INDEX_THRESHOLD;
+  while(capacity < 2 * static_cast<int>(links.size())) {
+    capacity *= 2;
+  }
+  this->keys.assign(capacity, NULL);
+  this->positions.assign(capacity, -1);
+  this->count = 0;
+  for(int i = 0; i < static_cast<int>(links.size()); ++i) {
+    insert(links[i], i);
+  }
+}
+
+int Link_Index::home_slot(Person* person) const {
+  // multiplicative hash of the address; the table size is a power of two
+  uint64_t h = (reinterpret_cast<uintptr_t>(person) >> 4) * 0x9E3779B97F4A7C15ull;
+  return static_cast<int>((h >> 32) & (this->keys.size() - 1));
+}
+
+int Link_Index::slot_of(Person* person) const {
+  int mask = this->keys.size() - 1;
+  int slot = home_slot(person);
+  while(this->keys[slot] != NULL && this->keys[slot] != person) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+int Link_Index::find(Person* person) const {
+  if(this->keys.empty()) {
+    return -1;
+  }
+  int slot = slot_of(person);
+  return (this->keys[slot] == person ? this->positions[slot] : -1);
+}
+
+void Link_Index::insert(Person* person, int position) {
+  // keep the load factor at or below 1/2
+  if(2 * (this->count + 1) > static_cast<int>(this->keys.size())) {
+    grow();
+  }
+  int slot = slot_of(person);
+  if(this->keys[slot] == NULL) {
+    this->keys[slot] = person;
+    this->count++;
+  }
+  this->positions[slot] = position;
+}
+
+void Link_Index::erase(Person* person) {
+  if(this->keys.empty()) {
+    return;
+  }
+  int slot = slot_of(person);
+  if(this->keys[slot] != person) {
+    return;
+  }
+  // backward-shift deletion keeps every probe sequence unbroken
+  int mask = this->keys.size() - 1;
+  int hole = slot;
+  int next = (hole + 1) & mask;
+  while(this->keys[next] != NULL) {
+    int home = home_slot(this->keys[next]);
+    // move the entry back if its home slot is not in (hole, next]
+    if(((next - home) & mask) >= ((next - hole) & mask)) {
+      this->keys[hole] = this->keys[next];
+      this->positions[hole] = this->positions[next];
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+  this->keys[hole] = NULL;
+  this->positions[hole] = -1;
+  this->count--;
+}
+
+void Link_Index::grow() {
+  std::vector<Person*> old_keys;
+  std::vector<int> old_positions;
+  old_keys.swap(this->keys);
+  old_positions.swap(this->positions);
+  int capacity = (old_keys.empty() ? 2 * LINK_INDEX_THRESHOLD : 2 * old_keys.size());
+  this->keys.assign(capacity, NULL);
+  this->positions.assign(capacity, -1);
+  this->count = 0;
+  for(int i = 0; i < static_cast<int>(old_keys.size()); ++i) {
+    if(old_keys[i] != NULL) {
+      int slot = slot_of(old_keys[i]);
+      this->keys[slot] = old_keys[i];
+      this->positions[slot] = old_positions[i];
+      this->count++;
+    }
+  }
+}
+
 Person_Network_Link::Person_Network_Link(Person* person, Network* network) {
   this->myself = person;
   this->network = NULL;
   this->enrollee_index = -1;
   this->links_to.clear();
   this->links_from.clear();
+  this->links_to_index = NULL;
+  this->links_from_index = NULL;
   this->enroll(this->myself, network);
 }
 
+Person_Network_Link::~Person_Network_Link() {
+  delete this->links_to_index;
+  delete this->links_from_index;
+}
+
+void Person_Network_Link::clear() {
+  this->links_to.clear();
+  this->links_from.clear();
+  delete this->links_to_index;
+  delete this->links_from_index;
+  this->links_to_index = NULL;
+  this->links_from_index = NULL;
+}
+
 void Person_Network_Link::enroll(Person* person, Network* new_network) {
   if(this->network != NULL) {
     FRED_VERBOSE(0,"enroll failed: network %s  enrollee_index %d \n",
@@ -83,53 +196,91 @@ void Person_Network_Link::destroy_link_to(Person* person) {
 
 // helper methods
 
-void Person_Network_Link::add_link_to(Person* person) {
-  int size = this->links_to.size();
-  for(int i = 0; i < size; ++i) {
-    if(person ==  this->links_to[i]) {
-      return;
-    }
+void Person_Network_Link::add_to_list(std::vector<Person*> &links, Link_Index* &index, Person* person) {
+  if(is_in_list(links, index, person)) {
+    return;
   }
+  links.push_back(person);
+  if(index != NULL) {
+    index->insert(person, links.size() - 1);
+  } else if(links.size() >= LINK_INDEX_THRESHOLD) {
+    index = new Link_Index;
+    index->build(links);
+  }
+}
 
-  // add person to my links_to list.
-  this->links_to.push_back(person);
+void Person_Network_Link::delete_from_list(std::vector<Person*> &links, Link_Index* &index, Person* person) {
+  if(index == NULL) {
+    int size = links.size();
+    for(int i = 0; i < size; ++i) {
+      if(person == links[i]) {
+        links[i] = links.back();
+        links.pop_back();
+        return;
+      }
+    }
+    return;
+  }
+  int pos = index->find(person);
+  if(pos < 0) {
+    return;
+  }
+  // move the last link into the hole, as the unindexed list does
+  Person* last = links.back();
+  links[pos] = last;
+  links.pop_back();
+  index->erase(person);
+  if(pos < static_cast<int>(links.size())) {
+    index->insert(last, pos);
+  }
 }
 
-void Person_Network_Link::add_link_from(Person* person) {
-  int size =  this->links_from.size();
+bool Person_Network_Link::is_in_list(const std::vector<Person*> &links, const Link_Index* index, Person* person) {
+  if(index != NULL) {
+    return index->find(person) >= 0;
+  }
+  int size = links.size();
   for(int i = 0; i < size; ++i) {
-    if(person ==  this->links_from[i]) {
-      return;
+    if(links[i] == person) {
+      return true;
     }
   }
+  return false;
+}
 
-  // add person to my links_from list.
-  this->links_from.push_back(person);
+void Person_Network_Link::set_list(std::vector<Person*> &links, Link_Index* &index, const std::vector<Person*> &people) {
+  links.clear();
+  delete index;
+  index = NULL;
+  links.reserve(people.size());
+  for(int i = 0; i < static_cast<int>(people.size()); ++i) {
+    add_to_list(links, index, people[i]);
+  }
+}
+
+void Person_Network_Link::add_link_to(Person* person) {
+  add_to_list(this->links_to, this->links_to_index, person);
+}
+
+void Person_Network_Link::add_link_from(Person* person) {
+  add_to_list(this->links_from, this->links_from_index, person);
 }
 
 void Person_Network_Link::delete_link_to(Person* person) {
-  // delete person from my links_to list.
-  int size =  this->links_to.size();
-  for(int i = 0; i < size; ++i) {
-    if(person ==  this->links_to[i]) {
-      this->links_to[i] =  this->links_to.back();
-      this->links_to.pop_back();
-    }
-  }
+  delete_from_list(this->links_to, this->links_to_index, person);
 }
 
 void Person_Network_Link::delete_link_from(Person* person) {
-  // delete person from my links_from list.
-  int size =  this->links_from.size();
-  for(int i = 0; i < size; i++) {
-    if(person ==  this->links_from[i]) {
-      this->links_from[i] =  this->links_from.back();
-      this->links_from.pop_back();
-    }
-  }
+  delete_from_list(this->links_from, this->links_from_index, person);
 }
 
+void Person_Network_Link::set_links_to(const std::vector<Person*> &people) {
+  set_list(this->links_to, this->links_to_index, people);
+}
 
+void Person_Network_Link::set_links_from(const std::vector<Person*> &people) {
+  set_list(this->links_from, this->links_from_index, people);
+}
 
 void Person_Network_Link::print(FILE *fp) {
   fprintf(fp,"%d ->", this->myself->get_id());
@@ -148,22 +299,9 @@ void Person_Network_Link::print(FILE *fp) {
 }
 
 bool Person_Network_Link::is_connected_to(Person* person) {
-  int size = this->links_to.size();
-  for(int i = 0; i < size; ++i) {
-    if(this->links_to[i] == person) {
-      return true;
-    }
-  }
-  return false;
+  return is_in_list(this->links_to, this->links_to_index, person);
 }
 
 bool Person_Network_Link::is_connected_from(Person* person) {
-  int size = this->links_from.size();
-  for(int i = 0; i < size; ++i) {
-    if(this->links_from[i] == person) {
-      return true;
-    }
-  }
-  return false;
+  return is_in_list(this->links_from, this->links_from_index, person);
 }
-
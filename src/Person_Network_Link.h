@@ -16,12 +16,55 @@
 #ifndef _FRED_PERSON_NETWORK_LINK_H
 #define _FRED_PERSON_NETWORK_LINK_H
 
+#include <stdio.h>
+#include <vector>
+
 class Person;
 class Network;
 
+// link lists with at least this many entries get a Link_Index
+#define LINK_INDEX_THRESHOLD 16
+
+/*
+ * Open-addressed hash table from a linked Person to its position in a link
+ * list, so that membership tests and deletions do not scan the list.
+ */
+class Link_Index {
+ public:
+  Link_Index() {
+    this->count = 0;
+  }
+
+  /**
+   * Index every entry of links
+   */
+  void build(const std::vector<Person*> &links);
+
+  /**
+   * @return the position of person in the link list, or -1
+   */
+  int find(Person* person) const;
+
+  /**
+   * Add person at the given position, or move person there if present
+   */
+  void insert(Person* person, int position);
+
+  void erase(Person* person);
+
+ private:
+  int home_slot(Person* person) const;
+  int slot_of(Person* person) const;
+  void grow();
+
+  std::vector<Person*> keys;
+  std::vector<int> positions;
+  int count;
+};
+
 class Person_Network_Link {
  public:
-  ~Person_Network_Link() {}
+  ~Person_Network_Link();
   Person_Network_Link(Person* person, Network* network);
 
   void enroll(Person* person, Network* new_network);
@@ -47,20 +90,38 @@ class Person_Network_Link {
   int get_in_degree() {
     return this->links_from.size();
   }
-  void clear() {
-    this->links_to.clear();
-    this->links_from.clear();
-  }
+  void clear();
   Person * get_end_of_link(int n) {
     return this->links_to[n];
   }
+  const std::vector<Person*> &get_links_to() {
+    return this->links_to;
+  }
+
+  /**
+   * Replace all links in one step (used when a whole network is built at once).
+   * Duplicate entries are dropped; the links of the other endpoints are not changed.
+   */
+  void set_links_to(const std::vector<Person*> &people);
+  void set_links_from(const std::vector<Person*> &people);
 
  private:
+  static void add_to_list(std::vector<Person*> &links, Link_Index* &index, Person* person);
+  static void delete_from_list(std::vector<Person*> &links, Link_Index* &index, Person* person);
+  static bool is_in_list(const std::vector<Person*> &links, const Link_Index* index, Person* person);
+  static void set_list(std::vector<Person*> &links, Link_Index* &index, const std::vector<Person*> &people);
+
   Person* myself;
   Network* network;
   int enrollee_index;
   std::vector<Person*> links_to;
   std::vector<Person*> links_from;
+  // NULL until the corresponding list reaches LINK_INDEX_THRESHOLD entries
+  Link_Index* links_to_index;
+  Link_Index* links_from_index;
+
+  Person_Network_Link(const Person_Network_Link &);
+  void operator=(const Person_Network_Link &);
 };
 
 #endif // _FRED_PERSON_NETWORK_LINK_H
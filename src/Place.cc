@@ -22,6 +22,7 @@
 #include "Disease.h"
 #include "Disease_List.h"
 #include "Global.h"
+#include "Health.h"
 #include "Household.h"
 #include "Infection.h"
 #include "Neighborhood.h"
@@ -58,6 +59,8 @@ char Place::SUBTYPE_NURSING_HOME = 'N';
 char Place::SUBTYPE_HEALTHCARE_CLINIC = 'I';
 char Place::SUBTYPE_MOBILE_HEALTHCARE_CLINIC = 'Z';
 
+int Place::Daily_counts_day = 0;
+
 
 Place::Place() : Mixing_Group("BLANK") {
   this->set_id(-1);      // actual id assigned in Place_List::add_place
@@ -105,6 +108,7 @@ Place::Place() : Mixing_Group("BLANK") {
   this->vector_disease_data = NULL;
   this->vectors_have_been_infected_today = false;
   this->vector_control_status = false;
+  this->face_mask_location = -1;
 }
 
 Place::Place(const char* lab, fred::geo lon, fred::geo lat) : Mixing_Group(lab) {
@@ -151,6 +155,7 @@ Place::Place(const char* lab, fred::geo lon, fred::geo lat) : Mixing_Group(lab)
   this->vector_disease_data = NULL;
   this->vectors_have_been_infected_today = false;
   this->vector_control_status = false;
+  this->face_mask_location = -1;
 }
 
 void Place::prepare() {
@@ -172,6 +177,10 @@ void Place::prepare() {
 
   Global::Neighborhoods->register_place(this);
 
+  if(Global::Enable_Face_Mask_Usage) {
+    this->face_mask_location = Health::find_face_mask_location(this);
+  }
+
   FRED_VERBOSE(2, "Prepare place %d label %s type %c\n", this->get_id(), this->get_label(), this->get_type());
 }
 
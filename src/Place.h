@@ -183,6 +183,14 @@ public:
   string get_place_subtype();
   string get_household_type();
 
+  /**
+   * @return the index of the face_mask_locations entry that applies here, or -1
+   * if it has not been resolved yet (see Health::find_face_mask_location)
+   */
+  int get_face_mask_location() {
+    return this->face_mask_location;
+  }
+
   /**
    * Get the latitude.
    *
@@ -337,6 +345,14 @@ public:
   
   static char* get_place_label(Place* p);
 
+  /**
+   * Start a new day for the daily counts that places reset lazily (see
+   * Household::update_healthcare_info_day)
+   */
+  static void advance_daily_counts_day() {
+    Place::Daily_counts_day++;
+  }
+
   double get_seeds(int dis, int sim_day);
 
   /*
@@ -398,6 +414,9 @@ public:
 protected:
   static double** prob_contact;
 
+  // number of days started by advance_daily_counts_day()
+  static int Daily_counts_day;
+
   fred::geo latitude;     // geo location
   fred::geo longitude;    // geo location
   int close_date;         // this place will be closed during:
@@ -417,6 +436,9 @@ protected:
   bool vectors_have_been_infected_today;
   bool vector_control_status;
 
+  // face mask location resolved in prepare()
+  signed char face_mask_location;
+
   // Place_List, Neighborhood_Layer and Neighborhood_Patch are friends so that they can access
   // the Place Allocator.
   friend class Place_List;
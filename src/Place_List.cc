@@ -821,6 +821,8 @@ void Place_List::read_all_places(const std::vector<Utils::Tokens> &Demes) {
   this->hospitals.clear();
   this->counties.clear();
   this->census_tracts.clear();
+  this->county_index_map.clear();
+  this->census_tract_index_map.clear();
   this->nursing_home_residents_vector.clear();
   
   // store the number of demes as member variable
@@ -932,10 +934,6 @@ void Place_List::read_all_places(const std::vector<Utils::Tokens> &Demes) {
       this->households.push_back(h);
       //FRED_VERBOSE(9, "pushing household %s\n", s);
       this->counties[(*itr).county]->add_household(h);
-      if(Global::Enable_Visualization_Layer) {
-        long int census_tract = this->get_census_tract_with_index((*itr).census_tract_index);
-        Global::Visualization->add_census_tract(census_tract);
-      }
     } else if(place_type == Place::TYPE_SCHOOL) {
       place = new (school_allocator.get_free()) School(s, place_subtype, lon, lat);
       (static_cast<School*>(place))->set_county_index((*itr).county);
@@ -982,6 +980,9 @@ void Place_List::read_all_places(const std::vector<Utils::Tokens> &Demes) {
   add_preallocated_places<School>(Place::TYPE_SCHOOL, school_allocator);
   add_preallocated_places<Workplace>(Place::TYPE_WORKPLACE, workplace_allocator);
   add_preallocated_places<Hospital>(Place::TYPE_HOSPITAL, hospital_allocator);
+  this->household_id_table.finalize();
+  this->workplace_id_table.finalize();
+  this->school_id_table.finalize();
 
   FRED_STATUS(0, "finished reading %d locations, now creating additional FRED locations\n", next_place_id);
 
@@ -1117,6 +1118,114 @@ void Place_List::read_places(const char* pop_dir, const char* pop_id, unsigned c
   }
 }
 
+// A place read from a location file, with the county fips code and census
+// tract code not yet resolved to indices
+struct Place_File_Record {
+  Place_Init_Data pid;
+  int fips;
+  long int census_tract;
+  bool has_census_tract;
+
+  Place_File_Record(const Place_Init_Data &_pid, int _fips = -1, long int _census_tract = -1,
+      bool _has_census_tract = false) : pid(_pid) {
+    fips = _fips;
+    census_tract = _census_tract;
+    has_census_tract = _has_census_tract;
+  }
+};
+
+// Parse the lines of a memory-mapped location file in parallel.  Each thread
+// parses a chunk of whole lines; parse_line receives a writable copy of each
+// line (newline included, as returned by fgets) and appends zero or more
+// records.  The records are returned in file order, so the results do not
+// depend on the number of threads.
+template<typename Line_Parser>
+static void parse_location_file(const Utils::Mapped_File &file, int max_line_length, Line_Parser parse_line,
+    std::vector<Place_File_Record> &records) {
+
+  std::vector<const char*> bounds;
+  file.split_into_line_chunks(fred::omp_get_max_threads(), bounds);
+  int number_of_chunks = (int)bounds.size() - 1;
+  std::vector<std::vector<Place_File_Record> > chunk_records(number_of_chunks);
+
+#pragma omp parallel for schedule(static,1)
+  for(int c = 0; c < number_of_chunks; ++c) {
+    std::vector<char> line(max_line_length);
+    Utils::Tokens tokens;
+    const char* p = bounds[c];
+    const char* end = bounds[c + 1];
+    while(p < end) {
+      const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+      const char* next = (eol == NULL ? end : eol + 1);
+      size_t len = std::min<size_t>(next - p, max_line_length - 1);
+      memcpy(&line[0], p, len);
+      line[len] = '\0';
+      parse_line(&line[0], tokens, chunk_records[c]);
+      tokens.clear();
+      p = next;
+    }
+  }
+
+  size_t total = 0;
+  for(int c = 0; c < number_of_chunks; ++c) {
+    total += chunk_records[c].size();
+  }
+  records.reserve(records.size() + total);
+  for(int c = 0; c < number_of_chunks; ++c) {
+    records.insert(records.end(), chunk_records[c].begin(), chunk_records[c].end());
+    std::vector<Place_File_Record>().swap(chunk_records[c]);
+  }
+}
+
+// grab the first five digits of stcotrbg to get the county fips code
+static int get_fips_from_stcotrbg(const char* stcotrbg) {
+  char fipstr[8];
+  int fips = 0;
+  strncpy(fipstr, stcotrbg, 5);
+  fipstr[5] = '\0';
+  sscanf(fipstr, "%d", &fips);
+  return fips;
+}
+
+// Grab the first eleven (state and county + six) digits of stcotrbg to get the census tract
+// e.g 090091846001 StateCo = 09009, 184600 is the census tract, throw away the 1
+static long int get_census_tract_from_stcotrbg(const char* stcotrbg, int digits = 11) {
+  char census_tract_str[12];
+  long int census_tract = 0;
+  strncpy(census_tract_str, stcotrbg, digits);
+  census_tract_str[digits] = '\0';
+  sscanf(census_tract_str, "%ld", &census_tract);
+  return census_tract;
+}
+
+int Place_List::find_county_index(int fips, bool add_if_missing) {
+  std::unordered_map<int, int>::const_iterator itr = this->county_index_map.find(fips);
+  if(itr != this->county_index_map.end()) {
+    return itr->second;
+  }
+  if(!add_if_missing) {
+    return -1;
+  }
+  int index = this->counties.size();
+  this->counties.push_back(new County(fips));
+  this->county_index_map[fips] = index;
+  return index;
+}
+
+int Place_List::find_census_tract_index(long int census_tract, bool add_if_missing) {
+  std::unordered_map<long int, int>::const_iterator itr = this->census_tract_index_map.find(census_tract);
+  if(itr != this->census_tract_index_map.end()) {
+    return itr->second;
+  }
+  if(!add_if_missing) {
+    return -1;
+  }
+  int index = this->census_tracts.size();
+  this->census_tracts.push_back(census_tract);
+  this->census_tract_index_map[census_tract] = index;
+  return index;
+}
+
 void Place_List::read_household_file(unsigned char deme_id, char* location_file, InitSetT &pids) {
 
   enum column_index {
@@ -1131,11 +1240,16 @@ void Place_List::read_household_file(unsigned char deme_id, char* location_file,
     longitude = 8
   };
 
-  FILE* fp = Utils::fred_open_file(location_file);
-  char line_str[1024];
-  Utils::Tokens tokens;
+  Utils::Mapped_File file;
+  if(!file.open(location_file)) {
+    Utils::fred_abort("household file |%s| NOT FOUND\n", location_file);
+  }
 
-  for(char* line = line_str; fgets(line, 1024, fp); line = line_str) {
+  // Colombian census tracts are just 8 digits
+  int census_tract_digits = (Global::Enable_Vector_Transmission ? 8 : 11);
+
+  std::vector<Place_File_Record> records;
+  parse_location_file(file, 1024, [&](char* line, Utils::Tokens &tokens, std::vector<Place_File_Record> &out) {
     tokens = Utils::split_by_delim(line, ',', tokens, false);
 
     // skip header line
@@ -1143,68 +1257,27 @@ void Place_List::read_household_file(unsigned char deme_id, char* location_file,
       char place_type = Place::TYPE_HOUSEHOLD;
       char place_subtype = Place::SUBTYPE_NONE;
       char s[80];
-      char fipstr[8];
-      char census_tract_str[12];
-      long int census_tract = 0;
-      int fips = 0;
-      int county = 0;
-      int tract_index = 0;
 
       sprintf(s, "%c%s", place_type, tokens[hh_id]);
+      out.push_back(Place_File_Record(
+          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, -1, -1,
+              tokens[hh_income]),
+          get_fips_from_stcotrbg(tokens[stcotrbg]),
+          get_census_tract_from_stcotrbg(tokens[stcotrbg], census_tract_digits), true));
+    }
+  }, records);
+  file.close();
 
-      // grab the first five digits of stcotrbg to get the county fips code
-      strncpy(fipstr, tokens[stcotrbg], 5);
-      fipstr[5] = '\0';
-      sscanf(fipstr, "%d", &fips);
-
-      // Grab the first eleven (state and county + six) digits of stcotrbg to get the census tract
-      // e.g 090091846001 StateCo = 09009, 184600 is the census tract, throw away the 1
-
-      if(Global::Enable_Vector_Transmission) {
-	// Colombian census tracks are just 8 digits
-	strncpy(census_tract_str, tokens[stcotrbg], 8);
-	census_tract_str[8] = '\0';
-      }else{
-	strncpy(census_tract_str, tokens[stcotrbg], 11);
-	census_tract_str[11] = '\0';
-      }
-      sscanf(census_tract_str, "%ld", &census_tract);
-
-      // find the index for this census tract
-      int n_census_tracts = this->census_tracts.size();
-      for(tract_index = 0; tract_index < n_census_tracts; ++tract_index) {
-        if(this->census_tracts[tract_index] == census_tract) {
-          break;
-        }
-      }
-      if(tract_index == n_census_tracts) {
-        this->census_tracts.push_back(census_tract);
-      }
-
-      // find the county index for this fips code
-      int n_counties = this->counties.size();
-      for(county = 0; county < n_counties; county++) {
-        if(this->counties[county]->get_fips() == fips) {
-          break;
-        }
-      }
-      if(county == n_counties) {
-        County* new_county = new County(fips);
-        this->counties.push_back(new_county);
-      }
-
-      SetInsertResultT result = pids.insert(
-          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
-              tract_index, tokens[hh_income]));
-
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
+  // resolve counties and census tracts in file order
+  for(int i = 0; i < static_cast<int>(records.size()); ++i) {
+    Place_Init_Data &pid = records[i].pid;
+    pid.census_tract_index = find_census_tract_index(records[i].census_tract, true);
+    pid.county = find_county_index(records[i].fips, true);
+    SetInsertResultT result = pids.insert(pid);
+    if(result.second) {
+      ++(this->place_type_counts[pid.place_type]);
     }
-    tokens.clear();
   }
-  fclose(fp);
-
 }
 
 void Place_List::read_workplace_file(unsigned char deme_id, char* location_file, InitSetT &pids) {
@@ -1213,11 +1286,13 @@ void Place_List::read_workplace_file(unsigned char deme_id, char* location_file,
     workplace_id = 0, num_workers_assigned = 1, latitude = 2, longitude = 3
   };
 
-  FILE* fp = Utils::fred_open_file(location_file);
-  char line_str[255];
-  Utils::Tokens tokens;
+  Utils::Mapped_File file;
+  if(!file.open(location_file)) {
+    Utils::fred_abort("workplace file |%s| NOT FOUND\n", location_file);
+  }
 
-  for(char* line = line_str; fgets(line, 255, fp); line = line_str) {
+  std::vector<Place_File_Record> records;
+  parse_location_file(file, 255, [&](char* line, Utils::Tokens &tokens, std::vector<Place_File_Record> &out) {
     tokens = Utils::split_by_delim(line, ',', tokens, false);
     // skip header line
     if(strcmp(tokens[workplace_id], "workplace_id") != 0 && strcmp(tokens[workplace_id], "sp_id") != 0) {
@@ -1226,17 +1301,18 @@ void Place_List::read_workplace_file(unsigned char deme_id, char* location_file,
       char s[80];
 
       sprintf(s, "%c%s", place_type, tokens[workplace_id]);
+      out.push_back(Place_File_Record(
+          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id)));
+    }
+  }, records);
+  file.close();
 
-      SetInsertResultT result = pids.insert(
-          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id));
-
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
+  for(int i = 0; i < static_cast<int>(records.size()); ++i) {
+    SetInsertResultT result = pids.insert(records[i].pid);
+    if(result.second) {
+      ++(this->place_type_counts[records[i].pid.place_type]);
     }
-    tokens.clear();
   }
-  fclose(fp);
 }
 
 void Place_List::read_hospital_file(unsigned char deme_id, char* location_file, InitSetT &pids) {
@@ -1249,35 +1325,36 @@ void Place_List::read_hospital_file(unsigned char deme_id, char* location_file,
     workplace_id = 0, num_workers_assigned = 1, latitude = 2, longitude = 3
   };
 
-  FILE* fp = Utils::fred_open_file(location_file);
-  if(fp == NULL) {
+  Utils::Mapped_File file;
+  if(!file.open(location_file)) {
     return;
   }
-  char line_str[255];
-  int workers = 0;
-  Utils::Tokens tokens;
 
-  for(char* line = line_str; fgets(line, 255, fp); line = line_str) {
+  std::vector<Place_File_Record> records;
+  parse_location_file(file, 255, [&](char* line, Utils::Tokens &tokens, std::vector<Place_File_Record> &out) {
     tokens = Utils::split_by_delim(line, ',', tokens, false);
     // skip header line
     if(strcmp(tokens[workplace_id], "workplace_id") != 0 && strcmp(tokens[workplace_id], "sp_id") != 0) {
       char place_type = Place::TYPE_HOSPITAL;
       char place_subtype = Place::SUBTYPE_NONE;
       char s[80];
+      int workers = 0;
 
       sprintf(s, "%c%s", place_type, tokens[workplace_id]);
       sscanf(tokens[num_workers_assigned], "%d", &workers);
-      SetInsertResultT result = pids.insert(
+      out.push_back(Place_File_Record(
           Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, 0, 0, "0", false,
-              workers));
+              workers)));
+    }
+  }, records);
+  file.close();
 
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
+  for(int i = 0; i < static_cast<int>(records.size()); ++i) {
+    SetInsertResultT result = pids.insert(records[i].pid);
+    if(result.second) {
+      ++(this->place_type_counts[records[i].pid.place_type]);
     }
-    tokens.clear();
   }
-  fclose(fp);
 }
 
 void Place_List::read_school_file(unsigned char deme_id, char* location_file, InitSetT &pids) {
@@ -1306,13 +1383,15 @@ void Place_List::read_school_file(unsigned char deme_id, char* location_file, In
     sch_type = 20
   };
 
-  FILE* fp = Utils::fred_open_file(location_file);
-  char line_str[1024];
-  Utils::Tokens tokens;
+  Utils::Mapped_File file;
+  if(!file.open(location_file)) {
+    Utils::fred_abort("school file |%s| NOT FOUND\n", location_file);
+  }
 
-  for(char* line = line_str; fgets(line, 1024, fp); line = line_str) {
-    if(strstr(line_str, "\"\"") != NULL) {
-      Utils::delete_char(line_str, '"', FRED_STRING_SIZE);
+  std::vector<Place_File_Record> records;
+  parse_location_file(file, 1024, [&](char* line, Utils::Tokens &tokens, std::vector<Place_File_Record> &out) {
+    if(strstr(line, "\"\"") != NULL) {
+      Utils::delete_char(line, '"', FRED_STRING_SIZE);
     }
     tokens = Utils::split_by_delim(line, ',', tokens, false);
     // skip header line
@@ -1321,75 +1400,51 @@ void Place_List::read_school_file(unsigned char deme_id, char* location_file, In
       char place_subtype = Place::SUBTYPE_NONE;
       char s[80];
 
-      // printf("|%s| |%s| |%s| |%s|\n", tokens[latitude], tokens[longitude], tokens[source], tokens[stco]); exit(0);
-
-      // get county index for this school
-      int county = -1;
+      // county fips for this school, -1 if unknown
+      int fips = -1;
       if(strcmp(tokens[stco], "-1") != 0) {
-        char fipstr[8];
-        int fips = 0;
-        // grab the first five digits of stcotrbg to get the county fips code
-        strncpy(fipstr, tokens[stco], 5);
-        fipstr[5] = '\0';
-        sscanf(fipstr, "%d", &fips);
-
-        // find the county index for this fips code
-        int n_counties = counties.size();
-        for(county = 0; county < n_counties; ++county) {
-          if(counties[county]->get_fips() == fips) {
-            break;
-          }
-        }
-        if(county == n_counties) {
-          // this school is outside the simulation region
-          county = -1;
-        }
+        fips = get_fips_from_stcotrbg(tokens[stco]);
       }
+
       string sch_income("0");
       if(sch_inc < tokens.size()){
 	sch_income = tokens[sch_inc];
       }
 
-      string school_type_tmp("0");
-      if(sch_type < tokens.size()){
-	school_type_tmp = tokens[sch_type];
-      }
-
-      int tract_index = -1;
+      long int census_tract = -1;
+      bool has_census_tract = false;
       if(stcotrbg < tokens.size()){
-	char census_tract_str[12];
-	long int census_tract = 0;
-	strncpy(census_tract_str, tokens[stcotrbg], 11);
-	census_tract_str[11] = '\0';
-	sscanf(census_tract_str, "%ld", &census_tract);
-
-	int n_census_tracts = this->census_tracts.size();
-	for(tract_index = 0; tract_index < n_census_tracts; ++tract_index) {
-	  if(this->census_tracts[tract_index] == census_tract) {
-	    break;
-	  }
-	}
-	if(tract_index == n_census_tracts) {
-	  this->census_tracts.push_back(census_tract);
-	}
-	//printf("READING SCHOOL %s - CENSUS TRACT %s (%ld) - INDeX: %d (out of %d)\n", tokens[school_id], census_tract_str, census_tract, tract_index, this->census_tracts.size());
+	census_tract = get_census_tract_from_stcotrbg(tokens[stcotrbg]);
+	has_census_tract = true;
       }
       sprintf(s, "%c%s", place_type, tokens[school_id]);
-      
-      SetInsertResultT result = pids.insert(
-	Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county, tract_index, sch_income.c_str()));
-      
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-        FRED_VERBOSE(1, "READ_SCHOOL: %s %c %f %f name |%s| county %d income %s\n", s, place_type, result.first->lat,
-		     result.first->lon, tokens[name], get_fips_of_county_with_index(county), sch_income.c_str());
-      }else{
-	printf("SCHOOL %s NOT ADDED to Place_List\n", s);
-      }
+
+      out.push_back(Place_File_Record(
+          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, -1, -1,
+              sch_income.c_str()),
+          fips, census_tract, has_census_tract));
+    }
+  }, records);
+  file.close();
+
+  for(int i = 0; i < static_cast<int>(records.size()); ++i) {
+    Place_Init_Data &pid = records[i].pid;
+    // schools outside the simulation region have no county
+    if(records[i].fips != -1) {
+      pid.county = find_county_index(records[i].fips, false);
+    }
+    if(records[i].has_census_tract) {
+      pid.census_tract_index = find_census_tract_index(records[i].census_tract, true);
+    }
+    SetInsertResultT result = pids.insert(pid);
+    if(result.second) {
+      ++(this->place_type_counts[pid.place_type]);
+      FRED_VERBOSE(1, "READ_SCHOOL: %s %c %f %f county %d income %d\n", pid.s, pid.place_type, result.first->lat,
+		   result.first->lon, get_fips_of_county_with_index(pid.county), pid.income);
+    }else{
+      printf("SCHOOL %s NOT ADDED to Place_List\n", pid.s);
     }
-    tokens.clear();
   }
-  fclose(fp);
 }
 
 void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_file, InitSetT &pids) {
@@ -1398,34 +1453,27 @@ void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_
     gq_id = 0, gq_type = 1, gq_size = 2, stcotrbg_a = 3, stcotrbg_b = 4, latitude = 5, longitude = 6
   };
 
-  FILE* fp = Utils::fred_open_file(location_file);
-  char line_str[1024];
-  Utils::Tokens tokens;
+  Utils::Mapped_File file;
+  if(!file.open(location_file)) {
+    Utils::fred_abort("group quarters file |%s| NOT FOUND\n", location_file);
+  }
 
-  char fipstr[8];
-  char census_tract_str[12];
-  long int census_tract = 0;
-  int fips = 0;
-  int county = 0;
-  int tract_index = 0;
-  int capacity = 0;
-  bool format_2010_ver1 = false;
+  // check for 2010_ver1 format
+  bool format_2010_ver1 = (file.get_size() >= 5 && strncmp(file.get_data(), "sp_id", 5) == 0);
 
-  for(char* line = line_str; fgets(line, 1024, fp); line = line_str) {
+  // each group quarters yields a workplace, a household, and possibly
+  // additional household units, all in the same county and census tract
+  std::vector<Place_File_Record> records;
+  parse_location_file(file, 1024, [&](char* line, Utils::Tokens &tokens, std::vector<Place_File_Record> &out) {
     tokens = Utils::split_by_delim(line, ',', tokens, false);
 
-    // check for 2010_ver1 format
-    if(strcmp(tokens[gq_id], "sp_id") == 0) {
-      format_2010_ver1 = true;
-    }
-
     // skip header line
     if(strcmp(tokens[gq_id], "gq_id") != 0 && strcmp(tokens[gq_id], "sp_id") != 0) {
       char s[80];
       char wp[80];
-      SetInsertResultT result;
       char place_type;
       char place_subtype = Place::SUBTYPE_NONE;
+      int capacity = 0;
 
       if(format_2010_ver1) {
         // the 2010_ver1 format omits the stcotrbg_b field
@@ -1440,38 +1488,8 @@ void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_
 
       sscanf(tokens[gq_size], "%d", &capacity);
 
-      // grab the first five digits of stcotrbg to get the county fips code
-      strncpy(fipstr, tokens[stcotrbg_b], 5);
-      fipstr[5] = '\0';
-      sscanf(fipstr, "%d", &fips);
-      // Grab the first eleven (state and county + six) digits of stcotrbg to get the census tract
-      // e.g 090091846001 StateCo = 09009, 184600 is the census tract, throw away the 1
-      strncpy(census_tract_str, tokens[stcotrbg_b], 11);
-      census_tract_str[11] = '\0';
-      sscanf(census_tract_str, "%ld", &census_tract);
-
-      // find the index for this census tract
-      int n_census_tracts = census_tracts.size();
-      for(tract_index = 0; tract_index < n_census_tracts; tract_index++) {
-        if(census_tracts[tract_index] == census_tract) {
-          break;
-        }
-      }
-      if(tract_index == n_census_tracts) {
-        census_tracts.push_back(census_tract);
-      }
-
-      // find the county index for this fips code
-      int n_counties = counties.size();
-      for(county = 0; county < n_counties; county++) {
-        if(counties[county]->get_fips() == fips) {
-          break;
-        }
-      }
-      if(county == n_counties) {
-        County* new_county = new County(fips);
-        this->counties.push_back(new_county);
-      }
+      int fips = get_fips_from_stcotrbg(tokens[stcotrbg_b]);
+      long int census_tract = get_census_tract_from_stcotrbg(tokens[stcotrbg_b]);
 
       // set number of units and subtype for this group quarters
       int number_of_units = 0;
@@ -1498,42 +1516,42 @@ void Place_List::read_group_quarters_file(unsigned char deme_id, char* location_
       // add a workplace for this group quarters
       place_type = Place::TYPE_WORKPLACE;
       sprintf(wp, "%c%s", place_type, tokens[gq_id]);
-
-      result = pids.insert(
-          Place_Init_Data(wp, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
-              tract_index, "0", true));
-
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-      }
+      out.push_back(Place_File_Record(
+          Place_Init_Data(wp, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, -1, -1, "0", true),
+          fips, census_tract, true));
 
       // add as household
       place_type = Place::TYPE_HOUSEHOLD;
       sprintf(s, "%c%s", place_type, tokens[gq_id]);
-      result = pids.insert(
-          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
-              tract_index, "0", true, 0, number_of_units, tokens[gq_type], wp));
-      if(result.second) {
-        ++(this->place_type_counts[place_type]);
-        FRED_VERBOSE(1, "READ_GROUP_QUARTERS: %s type %c size %d lat %f lon %f\n", s, place_type, capacity,
-            result.first->lat, result.first->lon);
-      }
+      out.push_back(Place_File_Record(
+          Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, -1, -1, "0", true,
+              0, number_of_units, tokens[gq_type], wp),
+          fips, census_tract, true));
 
       // generate additional household units associated with this group quarters
       for(int i = 1; i < number_of_units; ++i) {
         sprintf(s, "%c%s-%03d", place_type, tokens[gq_id], i);
-        result = pids.insert(
-            Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, county,
-                tract_index, "0", true, 0, 0, tokens[gq_type], wp));
-        if(result.second) {
-          ++(this->place_type_counts[place_type]);
-        }
-        FRED_VERBOSE(1, "Adding GQ Household %s out of %d units\n", s, number_of_units);
+        out.push_back(Place_File_Record(
+            Place_Init_Data(s, place_type, place_subtype, tokens[latitude], tokens[longitude], deme_id, -1, -1, "0",
+                true, 0, 0, tokens[gq_type], wp),
+            fips, census_tract, true));
       }
     }
-    tokens.clear();
+  }, records);
+  file.close();
+
+  for(int i = 0; i < static_cast<int>(records.size()); ++i) {
+    Place_Init_Data &pid = records[i].pid;
+    pid.census_tract_index = find_census_tract_index(records[i].census_tract, true);
+    pid.county = find_county_index(records[i].fips, true);
+    SetInsertResultT result = pids.insert(pid);
+    if(result.second) {
+      ++(this->place_type_counts[pid.place_type]);
+      FRED_CONDITIONAL_VERBOSE(1, pid.place_type == Place::TYPE_HOUSEHOLD && pid.group_quarters_units > 0,
+          "READ_GROUP_QUARTERS: %s type %c lat %f lon %f\n", pid.s, pid.place_type, result.first->lat,
+          result.first->lon);
+    }
   }
-  fclose(fp);
 }
 
 void Place_List::prepare() {
@@ -1648,20 +1666,9 @@ void Place_List::update(int day) {
   }
   
   if(Global::Enable_HAZEL) {
-    int number_places = this->places.size();
-    for(int p = 0; p < number_places; ++p) {
-      Place* place = this->places[p];
-
-      if(place->is_hospital()) {
-        Hospital* temp_hosp = static_cast<Hospital*>(place);
-        temp_hosp->reset_current_daily_patient_count();
-      }
-
-      if(place->is_household()) {
-        Household* temp_hh = static_cast<Household*>(place);
-        temp_hh->reset_healthcare_info();
-      }
-    }
+    // the daily counts of households and hospitals are reset the next time
+    // they are used; see Household::update_healthcare_info_day()
+    Place::advance_daily_counts_day();
   }
 
   FRED_STATUS(1, "update places finished\n", "");
@@ -1805,14 +1812,38 @@ Place* Place_List::get_place_from_label(const char* s) const {
   }
   string str(s);
 
-  if(this->place_label_map->find(str) != this->place_label_map->end()) {
-    return this->places[(*this->place_label_map)[str]];
+  LabelMapT::const_iterator itr = this->place_label_map->find(str);
+  if(itr != this->place_label_map->end()) {
+    return this->places[itr->second];
   } else {
     FRED_VERBOSE(1, "Help!  can't find place with label = %s\n", str.c_str());
     return NULL;
   }
 }
 
+Place* Place_List::get_place_from_sp_id(char place_type, const char* sp_id) const {
+  if(strcmp(sp_id, "-1") == 0) {
+    return NULL;
+  }
+
+  const Place_Id_Table* table = get_place_id_table(place_type);
+  char* end = NULL;
+  long long id = strtoll(sp_id, &end, 10);
+  if(table != NULL && end != sp_id && *end == '\0') {
+    int index = table->find(id);
+    if(index < 0) {
+      FRED_VERBOSE(1, "Help!  can't find place with label = %c%s\n", place_type, sp_id);
+      return NULL;
+    }
+    return this->places[index];
+  }
+
+  // ids that are not plain integers are only known by their label
+  char label[80];
+  sprintf(label, "%c%s", place_type, sp_id);
+  return get_place_from_label(label);
+}
+
 bool Place_List::add_place(Place* p) {
 
   FRED_CONDITIONAL_WARNING(p->get_id() != -1, "Place id (%d) was overwritten!", p->get_id());
@@ -1825,6 +1856,17 @@ bool Place_List::add_place(Place* p) {
     p->set_id(get_new_place_id());
     this->places.push_back(p);
     (*this->place_label_map)[str] = this->places.size() - 1;
+
+    // register numeric ids for the places referenced by the population files
+    Place_Id_Table* table = get_place_id_table(p->get_type());
+    if(table != NULL) {
+      const char* sp_id = p->get_label() + 1;
+      char* end = NULL;
+      long long id = strtoll(sp_id, &end, 10);
+      if(end != sp_id && *end == '\0') {
+        table->add(id, this->places.size() - 1);
+      }
+    }
     // printf("places now = %d\n", (int)(places.size())); fflush(stdout);
 
     if(p->is_neighborhood()) {
@@ -2670,6 +2712,9 @@ void Place_List::delete_place_label_map() {
     delete this->place_label_map;
     this->place_label_map = NULL;
   }
+  this->household_id_table.clear();
+  this->workplace_id_table.clear();
+  this->school_id_table.clear();
 }
 
 void Place_List::get_initial_visualization_data_from_households() {
@@ -2681,29 +2726,6 @@ void Place_List::get_initial_visualization_data_from_households() {
   }
 }
 
-void Place_List::get_visualization_data_from_households(int day, int disease_id, int output_code) {
-  int num_households = this->households.size();
-  for(int i = 0; i < num_households; ++i) {
-    Household* h = this->get_household_ptr(i);
-    int count = h->get_visualization_counter(day, disease_id, output_code);
-    int popsize = h->get_size();
-    // update appropriate visualization patch
-    Global::Visualization->update_data(h->get_latitude(), h->get_longitude(), count, popsize);
-  }
-}
-
-void Place_List::get_census_tract_data_from_households(int day, int disease_id, int output_code) {
-  int num_households = this->households.size();
-  for(int i = 0; i < num_households; ++i) {
-    Household* h = this->get_household_ptr(i);
-    int count = h->get_visualization_counter(day, disease_id, output_code);
-    int popsize = h->get_size();
-    int census_tract_index = h->get_census_tract_index();
-    long int census_tract = this->get_census_tract_with_index(census_tract_index);
-    Global::Visualization->update_data(census_tract, count, popsize);
-  }
-}
-
 void Place_List::report_household_incomes() {
 
   // initialize household income stats
@@ -3106,6 +3128,25 @@ void Place_List::update_community_contact_increase(int day){
   printf("Day: %d Updating PLACE_LIST community contact: %.2f\n", day, this->current_community_contact_rate);
 }
 
+void Place_List::shelter_household_from_maps(Household* h, int day, const std::vector<Time_Step_Map_Shelter*> &shelter_maps) {
+  for(int i = 0; i < static_cast<int>(shelter_maps.size()); ++i) {
+    double r = Random::draw_random();
+    double prob_shelter = shelter_maps[i]->shelter_compliance;
+    if(r < prob_shelter) {
+      if(shelter_maps[i]->min_age == 0 && shelter_maps[i]->max_age == 120) {
+	h->set_shelter(true);
+	h->set_shelter_start_day(day);
+	h->set_shelter_end_day(9999999);
+      } else {
+	h->set_shelter_by_age(true);
+	h->set_shelter_by_age_ages(shelter_maps[i]->min_age, shelter_maps[i]->max_age);
+	h->set_shelter_by_age_start_day(day);
+	h->set_shelter_by_age_end_day(9999999);
+      }
+    }
+  }
+}
+
 void Place_List::update_shelter_households(int day, int peak_day_, double proportion_peak_incidence,
 					   int days_of_decline) {    
   int sheltering_households = 0;
@@ -3204,6 +3245,34 @@ void Place_List::update_shelter_households(int day, int peak_day_, double propor
     }
   }
   */  
+  // the list of maps for all tracts is looked up once, not per household
+  std::vector<Time_Step_Map_Shelter*>* all_tracts_shelter = NULL;
+  if(daily_shelter.find(-1) != daily_shelter.end()) {
+    all_tracts_shelter = &daily_shelter.find(-1)->second;
+  }
+
+  // with no shelter maps active, every household stops sheltering today; after
+  // that has been done once nothing changes until a map becomes active again
+  bool update_households = sheltering_today_flag || !this->shelter_households_are_cleared;
+
+  if(!update_households) {
+    // idle day: no household is sheltering, household counts for today are not yet
+    // updated, and the population and infections come from the running totals
+    non_sheltering_pop = this->shelter_household_pop;
+    if(non_sheltering_pop > 0) {
+      non_sheltering_ar = 100.0 * (double)this->shelter_household_infections / static_cast<double>(non_sheltering_pop);
+    }
+    this->previous_shelter_compliance = shelter_compliance;
+    Global::Daily_Tracker->set_index_key_pair(day, "H_sheltering", sheltering_households);
+    Global::Daily_Tracker->set_index_key_pair(day, "N_sheltering", sheltering_pop);
+    Global::Daily_Tracker->set_index_key_pair(day, "C_sheltering", sheltering_new_infections);
+    Global::Daily_Tracker->set_index_key_pair(day, "AR_sheltering", sheltering_ar);
+    Global::Daily_Tracker->set_index_key_pair(day, "N_noniso", non_sheltering_pop);
+    Global::Daily_Tracker->set_index_key_pair(day, "C_noniso", non_sheltering_new_infections);
+    Global::Daily_Tracker->set_index_key_pair(day, "AR_noniso", non_sheltering_ar);
+    return;
+  }
+
   for(int i = 0; i < num_households; ++i) {
     Household* h = this->get_household_ptr(i);    
     // Draw a random number and decide whether to shelter or not
@@ -3212,50 +3281,18 @@ void Place_List::update_shelter_households(int day, int peak_day_, double propor
     h->set_shelter_end_day(day);
     if(sheltering_today_flag == true){
       // if All exists, then first check that shelter probability through all the options
-      if(h->is_sheltering_today(day)){
-	h->set_shelter_end_day(day);
-      }
       if(h->is_sheltering_by_age()){
 	h->set_shelter_by_age(false);
 	h->set_shelter_by_age_end_day(day);
       }
-      long int ct = this->get_census_tract_with_index(h->get_census_tract_index());
-      if(daily_shelter.find(-1) != daily_shelter.end()){	
-	for(int i = 0; i < daily_shelter.find(-1)->second.size();i++){
-	  double r = Random::draw_random();
-	  double prob_shelter = daily_shelter[-1][i]->shelter_compliance;
-	  if(r < prob_shelter){
-	    if(daily_shelter[-1][i]->min_age == 0 && daily_shelter[-1][i]->max_age == 120){
-	      h->set_shelter(true);
-	      h->set_shelter_start_day(day);
-	      h->set_shelter_end_day(9999999);
-	    }else{
-	      h->set_shelter_by_age(true);
-	      h->set_shelter_by_age_ages(daily_shelter[-1][i]->min_age, daily_shelter[-1][i]->max_age);
-	      h->set_shelter_by_age_start_day(day);
-	      h->set_shelter_by_age_end_day(9999999);
-	    }
-	  }
-	}
+      if(all_tracts_shelter != NULL) {
+	shelter_household_from_maps(h, day, *all_tracts_shelter);
       }
-      if(daily_shelter.find(ct) != daily_shelter.end()){
-	for(int i = 0; i < daily_shelter.find(ct)->second.size();i++){
-	  // if All doesn't exist, then check by census tract
-	  double r = Random::draw_random();
-	  double prob_shelter = daily_shelter[ct][i]->shelter_compliance;
-	  if(r < prob_shelter){
-	    if(daily_shelter[ct][i]->min_age == 0 && daily_shelter[ct][i]->max_age == 120){
-	      h->set_shelter(true);
-	      h->set_shelter_start_day(day);
-	      h->set_shelter_end_day(9999999);
-	    }else{
-	      h->set_shelter_by_age(true);
-	      h->set_shelter_by_age_ages(daily_shelter[ct][i]->min_age, daily_shelter[ct][i]->max_age);
-	      h->set_shelter_by_age_start_day(day);
-	      h->set_shelter_by_age_end_day(9999999);
-	    }
-	  }
-	}
+      long int ct = this->get_census_tract_with_index(h->get_census_tract_index());
+      std::unordered_map< long int, std::vector< Time_Step_Map_Shelter * > >::iterator tract_shelter = daily_shelter.find(ct);
+      if(tract_shelter != daily_shelter.end()) {
+	// if All doesn't exist, then check by census tract
+	shelter_household_from_maps(h, day, tract_shelter->second);
       }
     }
     /*
@@ -3293,6 +3330,8 @@ void Place_List::update_shelter_households(int day, int peak_day_, double propor
   }
   
   this->previous_shelter_compliance = shelter_compliance;
+  this->shelter_households_are_cleared = !sheltering_today_flag;
+  this->shelter_household_pop = sheltering_pop + non_sheltering_pop;
     
   if(sheltering_total_pop > 0) {
     sheltering_ar = 100.0 * (double)sheltering_total_infections / static_cast<double>(sheltering_total_pop);
@@ -3375,9 +3414,10 @@ int Place_List::get_housing_data(int* target_size, int* current_size) {
 }
 
 void Place_List::swap_houses(int house_index1, int house_index2) {
+  swap_houses(this->get_household_ptr(house_index1), this->get_household_ptr(house_index2));
+}
 
-  Household* h1 = this->get_household_ptr(house_index1);
-  Household* h2 = this->get_household_ptr(house_index2);
+void Place_List::swap_houses(Household* h1, Household* h2) {
   if(h1 == NULL || h2 == NULL)
     return;
 
@@ -16,6 +16,7 @@
 #ifndef _FRED_PLACE_LIST_H
 #define _FRED_PLACE_LIST_H
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -42,6 +43,78 @@ class Office;
 
 typedef std::unordered_map<std::string, int> LabelMapT;
 
+// Maps the numeric part of a place label (e.g. 11043889 for "H11043889")
+// to the place's index in Place_List::places.  Entries are collected while
+// places are added; finalize() then stores them densely (offset by the
+// smallest id) when the ids are compact, or in an integer hash map otherwise.
+class Place_Id_Table {
+public:
+
+  Place_Id_Table() {
+    clear();
+  }
+
+  void add(long long id, int index) {
+    this->entries.push_back(std::make_pair(id, index));
+  }
+
+  void finalize() {
+    this->dense.clear();
+    this->sparse.clear();
+    if(this->entries.empty()) {
+      return;
+    }
+    long long min_id = this->entries[0].first;
+    long long max_id = min_id;
+    for(int i = 1; i < static_cast<int>(this->entries.size()); ++i) {
+      min_id = std::min(min_id, this->entries[i].first);
+      max_id = std::max(max_id, this->entries[i].first);
+    }
+    this->min_id = min_id;
+    this->is_dense = (max_id - min_id) < 4 * (long long) this->entries.size() + 1024;
+    if(this->is_dense) {
+      this->dense.assign(max_id - min_id + 1, -1);
+      for(int i = 0; i < static_cast<int>(this->entries.size()); ++i) {
+        this->dense[this->entries[i].first - min_id] = this->entries[i].second;
+      }
+    } else {
+      this->sparse.reserve(this->entries.size());
+      for(int i = 0; i < static_cast<int>(this->entries.size()); ++i) {
+        this->sparse[this->entries[i].first] = this->entries[i].second;
+      }
+    }
+    std::vector<std::pair<long long, int> >().swap(this->entries);
+  }
+
+  // returns the place index for the given id, or -1 if not found
+  int find(long long id) const {
+    if(this->is_dense) {
+      long long offset = id - this->min_id;
+      if(offset < 0 || offset >= (long long) this->dense.size()) {
+        return -1;
+      }
+      return this->dense[offset];
+    }
+    std::unordered_map<long long, int>::const_iterator itr = this->sparse.find(id);
+    return (itr == this->sparse.end() ? -1 : itr->second);
+  }
+
+  void clear() {
+    this->is_dense = false;
+    this->min_id = 0;
+    std::vector<std::pair<long long, int> >().swap(this->entries);
+    std::vector<int>().swap(this->dense);
+    this->sparse.clear();
+  }
+
+private:
+  std::vector<std::pair<long long, int> > entries;
+  bool is_dense;
+  long long min_id;
+  std::vector<int> dense;
+  std::unordered_map<long long, int> sparse;
+};
+
 struct Time_Step_Map_Community_Contact {
   int sim_day_start;
   int sim_day_end;
@@ -125,6 +198,9 @@ public:
     this->schools.clear();
     this->workplaces.clear();
     this->next_place_id = 0;
+    this->shelter_households_are_cleared = false;
+    this->shelter_household_pop = 0;
+    this->shelter_household_infections = 0;
     init_place_type_name_lookup_map();
     this->place_label_map = new LabelMapT();
   }
@@ -158,6 +234,15 @@ public:
   void setup_household_income_quartile_sick_days();
   int get_min_household_income_by_percentile(int percentile);
   Place* get_place_from_label(const char* s) const;
+
+  /**
+   * Find a household, workplace or school by the id used in the synthetic
+   * population files (the label without its place type prefix).
+   * @param place_type the type of place
+   * @param sp_id the id string, "-1" if missing
+   * @return the place, or NULL if there is none
+   */
+  Place* get_place_from_sp_id(char place_type, const char* sp_id) const;
   Place* get_random_workplace();
   void assign_hospitals_to_households();
 
@@ -193,6 +278,16 @@ public:
   void report_shelter_stats(int day);
   
   void update_shelter_households(int day, int, double, int);
+
+  /**
+   * Counts a new infection of the first disease in a household, so that the shelter
+   * statistics can be reported without visiting every household.
+   */
+  void record_household_infection(int disease_id) {
+    if(disease_id == 0) {
+      this->shelter_household_infections++;
+    }
+  }
   int get_shelter_moving_average_days(){
     return this->Shelter_relax_post_peak_moving_average_days;
   }
@@ -211,9 +306,8 @@ public:
 
   int get_housing_data(int* target_size, int* current_size);
   void get_initial_visualization_data_from_households();
-  void get_visualization_data_from_households(int day, int disease_id, int output_code);
-  void get_census_tract_data_from_households(int day, int disease_id, int output_code);
   void swap_houses(int house_index1, int house_index2);
+  void swap_houses(Household* h1, Household* h2);
   void combine_households(int house_index1, int house_index2);
 
   Place* select_school(int county_index, int grade);
@@ -227,6 +321,14 @@ public:
     return this->counties[index];
   }
 
+  /**
+   * @param fips the county fips code
+   * @return the index of the county, or -1 if the fips code is not in the population
+   */
+  int get_index_of_county_with_fips(int fips) {
+    return find_county_index(fips, false);
+  }
+
   int get_fips_of_county_with_index(int index) {
     if(index < 0) {
       return 99999;
@@ -306,6 +408,14 @@ public:
     return this->census_tracts[index];
   }
 
+  /**
+   * @param census_tract the census tract code
+   * @return the index of the census tract, or -1 if the tract is not in the population
+   */
+  int get_index_of_census_tract(long int census_tract) {
+    return find_census_tract_index(census_tract, false);
+  }
+
   bool is_load_completed() {
     return this->load_completed;
   }
@@ -481,6 +591,24 @@ private:
   // list of census_tracts
   std::vector<long int> census_tracts;
 
+  // indices into counties and census_tracts, keyed by fips code and census tract code
+  std::unordered_map<int, int> county_index_map;
+  std::unordered_map<long int, int> census_tract_index_map;
+
+  /**
+   * @param fips the county fips code
+   * @param add_if_missing if true, a new County is created for an unknown fips code
+   * @return the index of the county, or -1 if not found
+   */
+  int find_county_index(int fips, bool add_if_missing);
+
+  /**
+   * @param census_tract the census tract code
+   * @param add_if_missing if true, an unknown census tract is added to the list
+   * @return the index of the census tract, or -1 if not found
+   */
+  int find_census_tract_index(long int census_tract, bool add_if_missing);
+
   static std::unordered_map<string,double> Face_mask_compliance;
   
   // mean size of "household" associated with group quarters
@@ -579,12 +707,16 @@ private:
   void report_household_incomes();
   void select_households_for_shelter();
   void shelter_household(Household* h);
+  void shelter_household_from_maps(Household* h, int day, const std::vector<Time_Step_Map_Shelter*> &shelter_maps);
   void select_households_for_shelter_by_age();
   void shelter_household_by_age(Household* h);
   void select_households_for_evacuation();
   void evacuate_household(Household* h);
   
   double previous_shelter_compliance;
+  bool shelter_households_are_cleared;  // true if the last update ended every household's shelter
+  int shelter_household_pop;  // household population at the last update that visited every household
+  int shelter_household_infections;  // total household infections of the first disease
   // For hospitalization
   HouseholdHospitalIDMapT household_hospital_map;
 
@@ -638,6 +770,26 @@ private:
   int next_place_id;
 
   LabelMapT* place_label_map;
+
+  // numeric id lookup for the places referenced by the population files
+  Place_Id_Table household_id_table;
+  Place_Id_Table workplace_id_table;
+  Place_Id_Table school_id_table;
+
+  Place_Id_Table* get_place_id_table(char place_type) {
+    if(place_type == Place::TYPE_HOUSEHOLD) {
+      return &this->household_id_table;
+    } else if(place_type == Place::TYPE_WORKPLACE) {
+      return &this->workplace_id_table;
+    } else if(place_type == Place::TYPE_SCHOOL) {
+      return &this->school_id_table;
+    }
+    return NULL;
+  }
+
+  const Place_Id_Table* get_place_id_table(char place_type) const {
+    return const_cast<Place_List*>(this)->get_place_id_table(place_type);
+  }
 };
 
 struct Place_Init_Data {
@@ -14,13 +14,16 @@
 // File: Population.cc
 //
 
+#include <algorithm>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <chrono>
 
 #include "Activities.h"
 #include "Age_Map.h"
 #include "AV_Manager.h"
 #include "Behavior.h"
+#include "Block_Compression.h"
 #include "Date.h"
 #include "Demographics.h"
 #include "Disease.h"
@@ -52,6 +55,7 @@ using namespace std::chrono;
 char Population::pop_outfile[FRED_STRING_SIZE];
 char Population::output_population_date_match[FRED_STRING_SIZE];
 int Population::output_population = 0;
+int Population::output_population_compressed = 0;
 bool Population::is_initialized = false;
 int Population::next_id = 0;
 
@@ -64,6 +68,7 @@ Population::Population() {
   this->av_manager = NULL;
   this->vacc_manager = NULL;
   this->enable_copy_files = 0;
+  this->av_takers_removed = 0;
 
   // reserve memory for lists
   this->death_list.reserve(1000);
@@ -100,6 +105,7 @@ void Population::get_parameters() {
       Params::get_param_from_string("pop_outfile", Population::pop_outfile);
       Params::get_param_from_string("output_population_date_match",
 				    Population::output_population_date_match);
+      Params::get_param_from_string("output_population_compressed", &Population::output_population_compressed);
     }
     Population::is_initialized = true;
   }
@@ -187,17 +193,17 @@ void Population::setup() {
   initialize_activities();
 
   if(Global::Verbose > 0) {
-    for(int d = 0; d < Global::Diseases.get_number_of_diseases(); ++d) {
-      int count = 0;
-      for(int p = 0; p < this->get_index_size(); ++p) {
-	      Person* person = get_person_by_index(p);
-	      if(person != NULL) {
-	        if(person->is_immune(d)) {
-	          count++;
-	        }
-	      }
-      }
-      FRED_STATUS(0, "number of residually immune people for disease %d = %d\n", d, count);
+    int number_of_diseases = Global::Diseases.get_number_of_diseases();
+    fred::Thread_Counts<int> immune(number_of_diseases);
+    parallel_for([&](Person* person) {
+	for(int d = 0; d < number_of_diseases; ++d) {
+	  if(person->is_immune(d)) {
+	    immune.add(d);
+	  }
+	}
+      });
+    for(int d = 0; d < number_of_diseases; ++d) {
+      FRED_STATUS(0, "number of residually immune people for disease %d = %d\n", d, immune.get_total(d));
     }
   }
   this->av_manager->reset();
@@ -278,41 +284,41 @@ Person_Init_Data Population::get_person_init_data(char* line,
   // initialized with default values
   Person_Init_Data pid = Person_Init_Data();
   strcpy(pid.label, tokens[col.p_id]);
-  // add type indicator to label for places
+  // ids of the primary places; "-1" if missing
+  const char* house_id = tokens[col.home_id];
+  const char* work_id = tokens[col.workplace_id];
+  const char* school_id = "-1";
   if(is_group_quarters_population) {
     pid.in_grp_qrtrs = true;
     sscanf(tokens[col.gq_type], "%c", &pid.gq_type);
-    // columns present in group quarters population
-    if(strcmp(tokens[col.home_id], "-1")) {
-      sprintf(pid.house_label, "H%s", tokens[col.home_id]);
-    }
-    if(strcmp(tokens[col.workplace_id], "-1")) {
-      sprintf(pid.work_label, "W%s", tokens[col.workplace_id]);
-    }
-    // printf("GQ person %s house %s work %s\n", pid.label, pid.house_label, pid.work_label);
   } else {
     // columns not present in group quarters population
     sscanf(tokens[col.relate], "%d", &pid.relationship);
     sscanf(tokens[col.race_str], "%d", &pid.race);
     // schools only defined for synth_people
-    if(strcmp(tokens[col.school_id], "-1")) {
-      sprintf(pid.school_label, "S%s", tokens[col.school_id]);
-    }
-    // standard formatting for house and workplace labels
-    if(strcmp(tokens[col.home_id], "-1")) {
-      sprintf(pid.house_label, "H%s", tokens[col.home_id]);
-    }
-    if(strcmp(tokens[col.workplace_id], "-1")) {
-      sprintf(pid.work_label, "W%s", tokens[col.workplace_id]);
-    }
+    school_id = tokens[col.school_id];
   }
   // age, sex same for synth_people and synth_gq_people
   sscanf(tokens[col.age_str], "%d", &pid.age);
   pid.sex = strcmp(tokens[col.sex_str], "1") == 0 ? 'M' : 'F';
-  // set pointer to primary places in init data object
-  pid.house = Global::Places.get_place_from_label(pid.house_label);
-  pid.work =  Global::Places.get_place_from_label(pid.work_label);
-  pid.school = Global::Places.get_place_from_label(pid.school_label);
+  // set pointer to primary places in init data object, looked up by
+  // numeric id rather than by label
+  pid.house = Global::Places.get_place_from_sp_id(Place::TYPE_HOUSEHOLD, house_id);
+  pid.work = Global::Places.get_place_from_sp_id(Place::TYPE_WORKPLACE, work_id);
+  pid.school = Global::Places.get_place_from_sp_id(Place::TYPE_SCHOOL, school_id);
+  // labels (type indicator + id) are only needed for messages
+  if(Global::Verbose > 0 || (pid.house == NULL && strcmp(house_id, "-1"))
+     || (pid.work == NULL && strcmp(work_id, "-1")) || (pid.school == NULL && strcmp(school_id, "-1"))) {
+    if(strcmp(house_id, "-1")) {
+      sprintf(pid.house_label, "H%s", house_id);
+    }
+    if(strcmp(work_id, "-1")) {
+      sprintf(pid.work_label, "W%s", work_id);
+    }
+    if(strcmp(school_id, "-1")) {
+      sprintf(pid.school_label, "S%s", school_id);
+    }
+  }
   // warn if we can't find workplace
   if(strcmp(pid.work_label, "-1") != 0 && pid.work == NULL) {
     FRED_VERBOSE(2, "WARNING: person %s -- no workplace found for label = %s\n", pid.label,
@@ -332,6 +338,47 @@ Person_Init_Data Population::get_person_init_data(char* line,
   return pid;
 }
 
+bool Population::parse_person_line(char* line, bool is_group_quarters_pop, bool &is_2010_ver1_format,
+				   std::vector<Person_Init_Data> &pidv) {
+
+  // check for 2010_ver1 format
+  if(strncmp(line, "sp_id", 5) == 0) {
+    is_2010_ver1_format = true;
+    return false;
+  }
+
+  // skip empty lines...
+  if((line[0] == '\0') || strncmp(line, "p_id", 4) == 0) {
+    return false;
+  }
+
+  const Person_Init_Data &pid = get_person_init_data(line,
+						     is_group_quarters_pop,
+						     is_2010_ver1_format);
+
+  // verbose printing of all person initialization data
+  if(Global::Verbose > 1) {
+    FRED_VERBOSE(1, "%s\n", pid.to_string().c_str());
+  }
+
+  //skip header line
+  if(strcmp(pid.label, "p_id") == 0) {
+    return false;
+  }
+
+  if(pid.house != NULL) {
+    // create a Person_Init_Data object
+    pidv.push_back(pid);
+  } else {
+    // we need at least a household (homeless people not yet supported), so
+    // skip this person
+    FRED_VERBOSE(0, "WARNING: skipping person %s -- %s %s\n", pid.label,
+		 "no household found for label =", pid.house_label);
+  }
+  FRED_VERBOSE(1, "person = %s -- house_label %s\n", pid.label, pid.house_label);
+  return true;
+}
+
 void Population::parse_lines_from_stream(std::istream &stream, bool is_group_quarters_pop) {
 
   // vector used for batch add of new persons
@@ -345,46 +392,41 @@ void Population::parse_lines_from_stream(std::istream &stream, bool is_group_qua
   while(stream.good()) {
     char line[FRED_STRING_SIZE];
     stream.getline(line, FRED_STRING_SIZE);
-
-    // check for 2010_ver1 format
-    if(strncmp(line, "sp_id", 5) == 0) {
-      is_2010_ver1_format = true;
-      continue;
-    }
-
-    // skip empty lines...
-    if((line[0] == '\0') || strncmp(line, "p_id", 4) == 0 || strncmp(line, "sp_id", 5) == 0) {
-      continue;
-    }
-
-    const Person_Init_Data &pid = get_person_init_data(line,
-						       is_group_quarters_pop,
-						       is_2010_ver1_format);
-
-    // verbose printing of all person initialization data
-    if(Global::Verbose > 1) {
-      FRED_VERBOSE(1, "%s\n", pid.to_string().c_str());
+    if(parse_person_line(line, is_group_quarters_pop, is_2010_ver1_format, pidv)) {
+      n++;
     }
-
-    //skip header line
-    if(strcmp(pid.label, "p_id") == 0) {
-      continue;
-    }
-
-    if(pid.house != NULL) {
-      // create a Person_Init_Data object
-      pidv.push_back(pid);
-    } else {
-      // we need at least a household (homeless people not yet supported), so
-      // skip this person
-      FRED_VERBOSE(0, "WARNING: skipping person %s -- %s %s\n", pid.label,
-		   "no household found for label =", pid.house_label);
-    }
-    FRED_VERBOSE(1, "person %d = %s -- house_label %s\n", n, pid.label, pid.house_label);
-    n++;
   } // <----- end while loop over stream
   FRED_VERBOSE(0, "end of stream, persons = %d\n", n);
 
+  add_persons(pidv);
+}
+
+int Population::parse_lines_from_buffer(char* buffer, size_t size, bool is_group_quarters_pop,
+					bool is_2010_ver1_format, std::vector<Person_Init_Data> &pidv) {
+  int n = 0;
+  char* end = buffer + size;
+  char* line = buffer;
+  while(line < end) {
+    char* eol = static_cast<char*>(memchr(line, '\n', end - line));
+    if(eol == NULL) {
+      eol = end;
+    }
+    if(eol - line >= FRED_STRING_SIZE) {
+      Utils::fred_abort("population file line exceeds %d characters\n", FRED_STRING_SIZE - 1);
+    }
+    // copy so that the line is terminated even at the end of the buffer
+    char line_copy[FRED_STRING_SIZE];
+    memcpy(line_copy, line, eol - line);
+    line_copy[eol - line] = '\0';
+    if(parse_person_line(line_copy, is_group_quarters_pop, is_2010_ver1_format, pidv)) {
+      n++;
+    }
+    line = eol + 1;
+  }
+  return n;
+}
+
+void Population::add_persons(std::vector<Person_Init_Data> &pidv) {
   // Iterate through vector of already parsed initialization data and
   // add to population bloque.  More efficient to do this in batches; also
   // preserves the (fine-grained) order in the population file.  Protect
@@ -401,6 +443,38 @@ void Population::parse_lines_from_stream(std::istream &stream, bool is_group_qua
   }
 }
 
+void Population::parse_block_compressed_file(const Block_Compressed_File &file, bool is_group_quarters_pop) {
+  bool is_2010_ver1_format = strncmp(file.get_first_line(), "sp_id", 5) == 0;
+  int number_of_blocks = file.get_number_of_blocks();
+
+  // blocks are uncompressed and parsed in parallel, then the persons are
+  // added in file order so that person ids do not depend on the thread count
+  std::vector< std::vector<Person_Init_Data> > block_pidv(number_of_blocks);
+  std::vector<int> block_count(number_of_blocks, 0);
+#pragma omp parallel
+  {
+    std::vector<char> buffer;
+#pragma omp for schedule(dynamic,1)
+    for(int i = 0; i < number_of_blocks; ++i) {
+      if(!file.uncompress_block(i, buffer)) {
+        Utils::fred_abort("block %d of compressed population file is corrupt\n", i);
+      }
+      if(!buffer.empty()) {
+        block_count[i] = parse_lines_from_buffer(&buffer[0], buffer.size(), is_group_quarters_pop,
+						 is_2010_ver1_format, block_pidv[i]);
+      }
+    }
+  }
+
+  int n = 0;
+  for(int i = 0; i < number_of_blocks; ++i) {
+    add_persons(block_pidv[i]);
+    n += block_count[i];
+    std::vector<Person_Init_Data>().swap(block_pidv[i]);
+  }
+  FRED_VERBOSE(0, "end of compressed blocks, persons = %d\n", n);
+}
+
 void Population::split_synthetic_populations_by_deme() {
   using namespace std;
   using namespace Utils;
@@ -511,6 +585,49 @@ void Population::read_population(const char* pop_dir, const char* pop_id, const
   bool is_group_quarters_pop = strcmp(pop_type, "gq_people") == 0 ? true : false;
   FILE* fp = NULL;
 
+  // try to open block compressed population file (see fbz)
+  sprintf(population_file, "%s/%s/%s_synth_%s.txt.fbz", pop_dir, pop_id, pop_id, pop_type);
+  fp = Utils::fred_open_file(population_file);
+  if(fp != NULL) {
+    fclose(fp);
+    // an fbz file older than the text file it was made from is stale
+    char text_file[FRED_STRING_SIZE];
+    strcpy(text_file, population_file);
+    text_file[strlen(text_file) - strlen(".fbz")] = '\0';
+    struct stat fbz_stat;
+    struct stat text_stat;
+    if(stat(population_file, &fbz_stat) == 0 && stat(text_file, &text_stat) == 0
+       && text_stat.st_mtime > fbz_stat.st_mtime) {
+      printf("population file %s is older than %s and is ignored\n", population_file, text_file);
+      fp = NULL;
+    }
+  }
+  if(fp != NULL) {
+    printf("reading block compressed population file %s\n", population_file);
+    if(this->enable_copy_files) {
+      sprintf(cmd, "cp %s %s", population_file, temp_file);
+      printf("COPY_FILE: %s\n", cmd);
+      fflush(stdout);
+      if(system(cmd) != 0) {
+        Utils::fred_abort("Error using system command \"%s\"\n", cmd);
+      }
+      pop_file = temp_file;
+    } else {
+      pop_file = population_file;
+    }
+    Block_Compressed_File file;
+    if(!file.open(pop_file)) {
+      Utils::fred_abort("population file %s is not a valid fbz file\n", population_file);
+    }
+    parse_block_compressed_file(file, is_group_quarters_pop);
+    file.close();
+    if(this->enable_copy_files) {
+      unlink(temp_file);
+    }
+    FRED_VERBOSE(0, "finished reading block compressed population, pop_size = %d\n", pop_size);
+    return;
+  }
+
 #if SNAPPY
 
   // try to open compressed population file
@@ -604,6 +721,9 @@ void Population::remove_dead_person_from_population(int day, Person* person) {
   }
   */
   FRED_VERBOSE(1, "DELETING PERSON: %d ...\n", person->get_id());
+  if(person->get_health()->takes_av()) {
+    remove_av_taker(person);
+  }
   person->terminate(day);
   FRED_VERBOSE(1, "DELETED PERSON: %d\n", person->get_id());
 
@@ -675,38 +795,34 @@ void Population::quality_control() {
   }
 
   if(Global::Verbose > 0) {
-    int n0, n5, n18, n65;
-    int count[20];
-    int total = 0;
-    n0 = n5 = n18 = n65 = 0;
-    // age distribution
-    for(int c = 0; c < 20; ++c) {
-      count[c] = 0;
-    }
-    for(int p = 0; p < this->get_index_size(); ++p) {
-      Person* person = get_person_by_index(p);
-      if(person == NULL) {
-        continue;
-      }
-      int a = person->get_age();
-
-      if(a < 5) {
-        n0++;
-      } else if(a < 18) {
-        n5++;
-      } else if(a < 65) {
-        n18++;
-      } else {
-        n65++;
-      }
-      int n = a / 5;
-      if(n < 20) {
-        count[n]++;
-      } else {
-        count[19]++;
-      }
-      total++;
-    }
+    // age distribution: 5-year age groups, then the four age groups below
+    enum { N0 = 20, N5, N18, N65, NUMBER_OF_BINS };
+    fred::Thread_Counts<int> age_counts(NUMBER_OF_BINS);
+    parallel_for([&](Person* person) {
+	int a = person->get_age();
+	if(a < 5) {
+	  age_counts.add(N0);
+	} else if(a < 18) {
+	  age_counts.add(N5);
+	} else if(a < 65) {
+	  age_counts.add(N18);
+	} else {
+	  age_counts.add(N65);
+	}
+	int n = a / 5;
+	if(n < 20) {
+	  age_counts.add(n);
+	} else {
+	  age_counts.add(19);
+	}
+      });
+    int count[NUMBER_OF_BINS];
+    age_counts.get_totals(count);
+    int n0 = count[N0];
+    int n5 = count[N5];
+    int n18 = count[N18];
+    int n65 = count[N65];
+    int total = n0 + n5 + n18 + n65;
     fprintf(Global::Statusfp, "\nAge distribution: %d people\n", total);
     for(int c = 0; c < 20; ++c) {
       fprintf(Global::Statusfp, "age %2d to %d: %6d (%.2f%%)\n", 5 * c, 5 * (c + 1) - 1, count[c],
@@ -724,24 +840,19 @@ void Population::quality_control() {
 	if(Global::Diseases.get_disease(d)->get_at_risk()->is_empty() == false) {
 	  Disease* dis = Global::Diseases.get_disease(d);
 	  int rcount[20];
-	  for(int c = 0; c < 20; ++c) {
-	    rcount[c] = 0;
-	  }
-	  for(int p = 0; p < this->get_index_size(); ++p) {
-	    Person* person = get_person_by_index(p);
-	    if(person == NULL) {
-	      continue;
-	    }
-	    int a = person->get_age();
-	    int n = a / 10;
-	    if(person->get_health()->is_at_risk(d) == true) {
-	      if(n < 20) {
-		rcount[n]++;
-	      } else {
-		rcount[19]++;
+	  fred::Thread_Counts<int> at_risk(20);
+	  parallel_for([&](Person* person) {
+	      int a = person->get_age();
+	      int n = a / 10;
+	      if(person->get_health()->is_at_risk(d) == true) {
+		if(n < 20) {
+		  at_risk.add(n);
+		} else {
+		  at_risk.add(19);
+		}
 	      }
-	    }
-	  }
+	    });
+	  at_risk.get_totals(rcount);
 	  fprintf(Global::Statusfp, "\n Age Distribution of At Risk for Disease %d: %d people\n", d,
 		  total);
 	  for(int c = 0; c < 10; ++c) {
@@ -931,128 +1042,75 @@ void Population::set_school_income_levels() {
   delete school_income_hh_mm;
 }
 
-void Population::report_mean_hh_income_per_school() {
-
-  assert(Global::Places.is_load_completed());
-  assert(Global::Pop.is_load_completed());
-  typedef std::map<School*, int> SchoolMapT;
+namespace {
 
-  SchoolMapT* school_enrollment_map = new SchoolMapT();
-  SchoolMapT* school_hh_income_map = new SchoolMapT();
+  // the number of students of each school, and the sum of some value of
+  // their households
+  typedef std::map<School*, std::pair<int, double> > School_Totals;
 
-  for(int p = 0; p < this->get_index_size(); ++p) {
-    Person* person = get_person_by_index(p);
-    if(person == NULL) {
-      continue;
+  void add_school_totals(School_Totals &totals, const School_Totals &partial) {
+    for(School_Totals::const_iterator itr = partial.begin(); itr != partial.end(); ++itr) {
+      std::pair<int, double> &total = totals[itr->first];
+      total.first += itr->second.first;
+      total.second += itr->second.second;
     }
+  }
 
-    if(person->get_school() == NULL) {
-      continue;
-    } else {
-      School* schl = static_cast<School*>(person->get_school());
-      SchoolMapT::iterator got = school_enrollment_map->find(schl);
-      //Try to find the school
-      if(got == school_enrollment_map->end()) {
-        //Add the school to the map
-        school_enrollment_map->insert(std::pair<School*, int>(schl, 1));
-        Household* student_hh = static_cast<Household*>(person->get_household());
-        if(student_hh == NULL) {
-          if(Global::Enable_Hospitals && person->is_hospitalized() && person->get_permanent_household() != NULL) {
-            student_hh = static_cast<Household*>(person->get_permanent_household());;
-          }
-        }
-        assert(student_hh != NULL);
-        std::pair<School*, int> my_insert(schl, student_hh->get_household_income());
-        school_hh_income_map->insert(my_insert);
-      } else {
-        //Update the values
-        school_enrollment_map->at(schl) += 1;
-        Household* student_hh = static_cast<Household*>(person->get_household());
-        if(student_hh == NULL) {
-          if(Global::Enable_Hospitals && person->is_hospitalized() && person->get_permanent_household() != NULL) {
-            student_hh = static_cast<Household*>(person->get_permanent_household());;
-          }
-        }
-        assert(student_hh != NULL);
-        school_hh_income_map->at(schl) += student_hh->get_household_income();
+  Household* get_student_household(Person* person) {
+    Household* student_hh = static_cast<Household*>(person->get_household());
+    if(student_hh == NULL) {
+      if(Global::Enable_Hospitals && person->is_hospitalized() && person->get_permanent_household() != NULL) {
+        student_hh = static_cast<Household*>(person->get_permanent_household());
       }
     }
+    assert(student_hh != NULL);
+    return student_hh;
   }
+}
+
+void Population::report_mean_hh_income_per_school() {
+
+  assert(Global::Places.is_load_completed());
+  assert(Global::Pop.is_load_completed());
+
+  School_Totals school_totals;
+  parallel_reduce(school_totals, [](Person* person, School_Totals &partial) {
+      if(person->get_school() != NULL) {
+        std::pair<int, double> &totals = partial[static_cast<School*>(person->get_school())];
+        totals.first++;
+        totals.second += get_student_household(person)->get_household_income();
+      }
+    }, add_school_totals);
 
   FRED_STATUS(0, "\nMEAN HOUSEHOLD INCOME STATS PER SCHOOL SUMMARY:\n");
-  for(SchoolMapT::iterator itr = school_enrollment_map->begin();
-      itr != school_enrollment_map->end(); ++itr) {
-    double enrollment_tot = static_cast<double>((*itr).second);
-    SchoolMapT::iterator got = school_hh_income_map->find((*itr).first);
-    double hh_income_tot = static_cast<double>((*got).second);
-    FRED_STATUS(0, "MEAN_HH_INCOME: %s %.2f\n", (*itr).first->get_label(),
+  for(School_Totals::iterator itr = school_totals.begin(); itr != school_totals.end(); ++itr) {
+    double enrollment_tot = static_cast<double>(itr->second.first);
+    double hh_income_tot = itr->second.second;
+    FRED_STATUS(0, "MEAN_HH_INCOME: %s %.2f\n", itr->first->get_label(),
 		(hh_income_tot / enrollment_tot));
   }
-
-  delete school_enrollment_map;
-  delete school_hh_income_map;
 }
 
 void Population::report_mean_hh_size_per_school() {
 
   assert(Global::Places.is_load_completed());
   assert(Global::Pop.is_load_completed());
-  typedef std::map<School*, int> SchoolMapT;
-
-  SchoolMapT* school_enrollment_map = new SchoolMapT();
-  SchoolMapT* school_hh_size_map = new SchoolMapT();
 
-  for(int p = 0; p < this->get_index_size(); ++p) {
-    Person* person = get_person_by_index(p);
-    if(person == NULL) {
-      continue;
-    }
-
-    if(person->get_school() == NULL) {
-      continue;
-    } else {
-      School* schl = static_cast<School*>(person->get_school());
-      SchoolMapT::iterator got = school_enrollment_map->find(schl);
-      //Try to find the school
-      if(got == school_enrollment_map->end()) {
-        //Add the school to the map
-        school_enrollment_map->insert(std::pair<School*, int>(schl, 1));
-        Household* student_hh = static_cast<Household*>(person->get_household());
-        if(student_hh == NULL) {
-          if(Global::Enable_Hospitals && person->is_hospitalized() && person->get_permanent_household() != NULL) {
-            student_hh = static_cast<Household*>(person->get_permanent_household());;
-          }
-        }
-        assert(student_hh != NULL);
-        std::pair<School*, int> my_insert(schl, student_hh->get_size());
-        school_hh_size_map->insert(my_insert);
-      } else {
-        //Update the values
-        school_enrollment_map->at(schl) += 1;
-        Household* student_hh = static_cast<Household*>(person->get_household());
-        if(student_hh == NULL) {
-          if(Global::Enable_Hospitals && person->is_hospitalized() && person->get_permanent_household() != NULL) {
-            student_hh = static_cast<Household*>(person->get_permanent_household());;
-          }
-        }
-        assert(student_hh != NULL);
-        school_hh_size_map->at(schl) += student_hh->get_size();
+  School_Totals school_totals;
+  parallel_reduce(school_totals, [](Person* person, School_Totals &partial) {
+      if(person->get_school() != NULL) {
+        std::pair<int, double> &totals = partial[static_cast<School*>(person->get_school())];
+        totals.first++;
+        totals.second += get_student_household(person)->get_size();
       }
-    }
-  }
+    }, add_school_totals);
 
   FRED_STATUS(0, "\nMEAN HOUSEHOLD SIZE STATS PER SCHOOL SUMMARY:\n");
-  for(SchoolMapT::iterator itr = school_enrollment_map->begin();
-      itr != school_enrollment_map->end(); ++itr) {
-    double enrollmen_tot = static_cast<double>((*itr).second);
-    SchoolMapT::iterator got = school_hh_size_map->find((*itr).first);
-    double hh_size_tot = (double)got->second;
-    FRED_STATUS(0, "MEAN_HH_SIZE: %s %.2f\n", (*itr).first->get_label(), (hh_size_tot / enrollmen_tot));
+  for(School_Totals::iterator itr = school_totals.begin(); itr != school_totals.end(); ++itr) {
+    double enrollmen_tot = static_cast<double>(itr->second.first);
+    double hh_size_tot = itr->second.second;
+    FRED_STATUS(0, "MEAN_HH_SIZE: %s %.2f\n", itr->first->get_label(), (hh_size_tot / enrollmen_tot));
   }
-
-  delete school_enrollment_map;
-  delete school_hh_size_map;
-
 }
 
 void Population::report_mean_hh_distance_from_school() {
@@ -1060,69 +1118,25 @@ void Population::report_mean_hh_distance_from_school() {
   assert(Global::Places.is_load_completed());
   assert(Global::Pop.is_load_completed());
 
-  typedef std::map<School*, int> SchoolMapT;
-  typedef std::map<School*, double> SchoolMapDist;
-
-  SchoolMapT* school_enrollment_map = new SchoolMapT();
-  SchoolMapDist* school_hh_distance_map = new SchoolMapDist();
-
-  for(int p = 0; p < this->get_index_size(); ++p) {
-    Person* person = get_person_by_index(p);
-    if(person == NULL) {
-      continue;
-    }
-
-    if(person->get_school() == NULL) {
-      continue;
-    } else {
-      School* schl = static_cast<School*>(person->get_school());
-      SchoolMapT::iterator got = school_enrollment_map->find(schl);
-      //Try to find the school
-      if(got == school_enrollment_map->end()) {
-        //Add the school to the map
-        school_enrollment_map->insert(std::pair<School*, int>(schl, 1));
-        Household* student_hh = static_cast<Household*>(person->get_household());
-        if(student_hh == NULL) {
-          if(Global::Enable_Hospitals && person->is_hospitalized() && person->get_permanent_household() != NULL) {
-            student_hh = static_cast<Household*>(person->get_permanent_household());;
-          }
-        }
-        assert(student_hh != NULL);
-        double distance = Geo::haversine_distance(person->get_school()->get_longitude(),
-						  person->get_school()->get_latitude(), student_hh->get_longitude(),
-						  student_hh->get_latitude());
-        std::pair<School*, int> my_insert(schl, distance);
-        school_hh_distance_map->insert(my_insert);
-      } else {
-        //Update the values
-        school_enrollment_map->at(schl) += 1;
-        Household* student_hh = static_cast<Household*>(person->get_household());
-        if(student_hh == NULL) {
-          if(Global::Enable_Hospitals && person->is_hospitalized() && person->get_permanent_household() != NULL) {
-            student_hh = static_cast<Household*>(person->get_permanent_household());;
-          }
-        }
-        assert(student_hh != NULL);
-        double distance = Geo::haversine_distance(person->get_school()->get_longitude(),
-						  person->get_school()->get_latitude(), student_hh->get_longitude(),
-						  student_hh->get_latitude());
-        school_hh_distance_map->at(schl) += distance;
+  School_Totals school_totals;
+  parallel_reduce(school_totals, [](Person* person, School_Totals &partial) {
+      if(person->get_school() != NULL) {
+        Household* student_hh = get_student_household(person);
+        std::pair<int, double> &totals = partial[static_cast<School*>(person->get_school())];
+        totals.first++;
+        totals.second += Geo::haversine_distance(person->get_school()->get_longitude(),
+						 person->get_school()->get_latitude(), student_hh->get_longitude(),
+						 student_hh->get_latitude());
       }
-    }
-  }
+    }, add_school_totals);
 
   FRED_STATUS(0, "\nMEAN HOUSEHOLD DISTANCE STATS PER SCHOOL SUMMARY:\n");
-  for(SchoolMapT::iterator itr = school_enrollment_map->begin();
-      itr != school_enrollment_map->end(); ++itr) {
-    double enrollmen_tot = static_cast<double>((*itr).second);
-    SchoolMapDist::iterator got = school_hh_distance_map->find((*itr).first);
-    double hh_distance_tot = (*got).second;
-    FRED_STATUS(0, "MEAN_HH_DISTANCE: %s %.2f\n", (*itr).first->get_label(),
+  for(School_Totals::iterator itr = school_totals.begin(); itr != school_totals.end(); ++itr) {
+    double enrollmen_tot = static_cast<double>(itr->second.first);
+    double hh_distance_tot = itr->second.second;
+    FRED_STATUS(0, "MEAN_HH_DISTANCE: %s %.2f\n", itr->first->get_label(),
 		(hh_distance_tot / enrollmen_tot));
   }
-
-  delete school_enrollment_map;
-  delete school_hh_distance_map;
 }
 
 void Population::report_mean_hh_stats_per_income_category() {
@@ -1582,24 +1596,19 @@ void Population::print_age_distribution(char* dir, char* date_string, int run) {
   sprintf(filename, "%s/age_dist_%s.%02d", dir, date_string, run);
   printf("print_age_dist entered, filename = %s\n", filename);
   fflush(stdout);
-  for(int i = 0; i < 21; ++i) {
-    count[i] = 0;
-  }
-  for(int p = 0; p < this->get_index_size(); ++p) {
-    Person* person = get_person_by_index(p);
-    if(person == NULL) {
-      continue;
-    }
-    int age = person->get_age();
-    if(0 <= age && age <= Demographics::MAX_AGE) {
-      count[age]++;
-    }
+  fred::Thread_Counts<int> age_counts(Demographics::MAX_AGE + 1);
+  parallel_for([&](Person* person) {
+      int age = person->get_age();
+      if(0 <= age && age <= Demographics::MAX_AGE) {
+	age_counts.add(age);
+      }
 
-    if(age > Demographics::MAX_AGE) {
-      count[Demographics::MAX_AGE]++;
-    }
-    assert(age >= 0);
-  }
+      if(age > Demographics::MAX_AGE) {
+	age_counts.add(Demographics::MAX_AGE);
+      }
+      assert(age >= 0);
+    });
+  age_counts.get_totals(count);
   fp = fopen(filename, "w");
   for(int i = 0; i < 21; ++i) {
     pct[i] = 100.0 * count[i] / this->pop_size;
@@ -1637,46 +1646,87 @@ Person* Population::select_random_person_by_age(int min_age, int max_age) {
 
 void Population::write_population_output_file(int day) {
 
-  //Loop over the whole population and write the output of each Person's to_string to the file
+  // Write each Person's to_string to the file.  Persons are formatted (and
+  // compressed, for an fbz file) in chunks that are shared among the
+  // threads, and the chunks are written in order.  The file is written by
+  // the background output thread, so the run does not wait on the disk.
   char population_output_file[FRED_STRING_SIZE];
-  sprintf(population_output_file, "%s/%s_%s.txt", Global::Output_directory, Population::pop_outfile,
-	  Date::get_date_string().c_str());
-  FILE* fp = fopen(population_output_file, "w");
+  sprintf(population_output_file, "%s/%s_%s.txt%s", Global::Output_directory, Population::pop_outfile,
+	  Date::get_date_string().c_str(), Population::output_population_compressed ? ".fbz" : "");
+  FILE* fp = Utils::fred_open_async_output_file(population_output_file);
   if(fp == NULL) {
     Utils::fred_abort("Help! population_output_file %s not found\n", population_output_file);
   }
-
-  // NOTE: use this idiom to loop through pop.
-  // Note that pop_size is the number of valid indexes, NOT the size of blq.
-  for(int p = 0; p < this->get_index_size(); ++p) {
-    Person* person = get_person_by_index(p);
-    if(person != NULL) {
-      fprintf(fp, "%s\n", person->to_string().c_str());
+  Block_Compressed_File::Writer* writer = NULL;
+  if(Population::output_population_compressed) {
+    writer = new Block_Compressed_File::Writer(fp, NULL, 0);
+  }
+
+  const int persons_per_chunk = 16384;
+  int index_size = this->get_index_size();
+  int number_of_chunks = (index_size + persons_per_chunk - 1) / persons_per_chunk;
+  int chunks_per_round = 4 * fred::omp_get_max_threads();
+  std::vector<std::string> text(chunks_per_round);
+  std::vector< std::vector<char> > compressed(chunks_per_round);
+  std::vector<size_t> compressed_size(chunks_per_round, 0);
+  for(int first = 0; first < number_of_chunks; first += chunks_per_round) {
+    int last = std::min(first + chunks_per_round, number_of_chunks);
+#pragma omp parallel for schedule(dynamic,1)
+    for(int c = first; c < last; ++c) {
+      std::string &buffer = text[c - first];
+      buffer.clear();
+      int end = std::min((c + 1) * persons_per_chunk, index_size);
+      for(int p = c * persons_per_chunk; p < end; ++p) {
+	Person* person = get_person_by_index(p);
+	if(person != NULL) {
+	  person->append_to_string(buffer);
+	  buffer += '\n';
+	}
+      }
+      if(writer != NULL && !buffer.empty()) {
+	std::vector<char> &block = compressed[c - first];
+	block.resize(Block_Compression::max_compressed_size(buffer.size()));
+	compressed_size[c - first] = Block_Compression::compress(buffer.data(), buffer.size(), &block[0]);
+      }
+    }
+    for(int c = first; c < last; ++c) {
+      const std::string &buffer = text[c - first];
+      if(buffer.empty()) {
+	continue;
+      }
+      if(writer != NULL) {
+	writer->write_compressed_block(&compressed[c - first][0], compressed_size[c - first], buffer.size());
+      } else {
+	fwrite(buffer.data(), sizeof(char), buffer.size(), fp);
+      }
     }
   }
+  if(writer != NULL) {
+    writer->finish();
+    delete writer;
+  }
   fflush(fp);
   fclose(fp);
 }
 
 void Population::get_age_distribution(int* count_males_by_age, int* count_females_by_age) {
+  // females are counted in the bins after the males
+  const int number_of_ages = Demographics::MAX_AGE + 1;
+  fred::Thread_Counts<int> age_counts(2 * number_of_ages);
+  parallel_for([&](Person* person) {
+      int age = person->get_age();
+      if(age > Demographics::MAX_AGE) {
+	age = Demographics::MAX_AGE;
+      }
+      if(person->get_sex() == 'F') {
+	age_counts.add(number_of_ages + age);
+      } else {
+	age_counts.add(age);
+      }
+    });
   for(int i = 0; i <= Demographics::MAX_AGE; ++i) {
-    count_males_by_age[i] = 0;
-    count_females_by_age[i] = 0;
-  }
-  for(int p = 0; p < this->get_index_size(); ++p) {
-    Person* person = get_person_by_index(p);
-    if(person == NULL) {
-      continue;
-    }
-    int age = person->get_age();
-    if(age > Demographics::MAX_AGE) {
-      age = Demographics::MAX_AGE;
-    }
-    if(person->get_sex() == 'F') {
-      count_females_by_age[age]++;
-    } else {
-      count_males_by_age[age]++;
-    }
+    count_males_by_age[i] = age_counts.get_total(i);
+    count_females_by_age[i] = age_counts.get_total(number_of_ages + i);
   }
 }
 
@@ -1694,6 +1744,7 @@ void Population::initialize_population_behavior() {
 void Population::initialize_activities() {
   // NOTE: use this idiom to loop through pop.
   // Note that pop_size is the number of valid indexes, NOT the size of blq.
+  // This pass draws random numbers, so it stays serial.
   for(int p = 0; p < this->get_index_size(); ++p) {
     Person* person = get_person_by_index(p);
     if(person != NULL) {
@@ -1713,13 +1764,39 @@ void Population::initialize_demographic_dynamics() {
   }
 }
 
+void Population::add_av_taker(Person* person) {
+  person->get_health()->set_av_takers_index(this->av_takers.size());
+  this->av_takers.push_back(person);
+}
+
+void Population::remove_av_taker(Person* person) {
+  int index = person->get_health()->get_av_takers_index();
+  if(index < 0) {
+    return;
+  }
+  assert(this->av_takers[index] == person);
+  this->av_takers[index] = NULL;
+  person->get_health()->set_av_takers_index(-1);
+  this->av_takers_removed++;
+  if(2 * this->av_takers_removed > static_cast<int>(this->av_takers.size())) {
+    // compact the list, keeping the remaining takers in the order they started
+    int n = 0;
+    for(int p = 0; p < static_cast<int>(this->av_takers.size()); ++p) {
+      if(this->av_takers[p] != NULL) {
+        this->av_takers[p]->get_health()->set_av_takers_index(n);
+        this->av_takers[n++] = this->av_takers[p];
+      }
+    }
+    this->av_takers.resize(n);
+    this->av_takers_removed = 0;
+  }
+}
+
 void Population::update_health_interventions(int day) {
-  // NOTE: use this idiom to loop through pop.
-  // Note that pop_size is the number of valid indexes, NOT the size of blq.
-  for(int p = 0; p < this->get_index_size(); ++p) {
-    Person* person = get_person_by_index(p);
-    if(person != NULL) {
-      person->update_health_interventions(day);
+  // only persons who have taken antivirals have interventions to update
+  for(int p = 0; p < static_cast<int>(this->av_takers.size()); ++p) {
+    if(this->av_takers[p] != NULL) {
+      this->av_takers[p]->update_health_interventions(day);
     }
   }
 }
@@ -43,6 +43,7 @@ class Place;
 
 
 class Person_Init_Data;
+class Block_Compressed_File;
 
 class Population {
 
@@ -133,6 +134,37 @@ public:
     return this->blq.get_index_size();
   }
 
+  /**
+   * Calls f(person) for every person in the population, sharing the
+   * persons among the OpenMP threads.  Use it only for passes that count,
+   * reduce or make decisions without random draws: draws in f would come
+   * from the calling thread's stream (see Random.h) and make the results
+   * depend on the number of threads, so passes that draw stay serial.
+   * f may change the person it is given, but anything shared must be
+   * counted with fred::Thread_Counts or gathered with parallel_reduce.
+   */
+  template<typename Functor>
+  void parallel_for(Functor f) {
+    Person_Visitor<Functor> visitor(f);
+    this->blq.parallel_apply(visitor);
+  }
+
+  /**
+   * Like parallel_for, but f(person, partial) adds to a partial result of
+   * its own thread.  The partial results start out default-constructed and
+   * are merged, in thread order, with combine(result, partial).
+   */
+  template<typename T, typename Functor, typename Combine>
+  void parallel_reduce(T &result, Functor f, Combine combine) {
+    std::vector<T> partial(fred::omp_get_max_threads());
+    parallel_for([&](Person* person) {
+	f(person, partial[fred::omp_get_thread_num()]);
+      });
+    for(int t = 0; t < static_cast<int>(partial.size()); ++t) {
+      combine(result, partial[t]);
+    }
+  }
+
   /**
    * Assign agents in Schools to specific Classrooms within the school
    */
@@ -215,8 +247,26 @@ public:
 
   void update_health_interventions(int day);
 
+  /**
+   * Add a person who has started taking antivirals to the list of persons
+   * visited by update_health_interventions()
+   */
+  void add_av_taker(Person* person);
+
 private:
 
+  // persons who have taken antivirals, in the order they started; a person
+  // who dies leaves a NULL slot, and the slots are compacted in order once
+  // half of the list is empty
+  std::vector<Person*> av_takers;
+  int av_takers_removed;
+
+  /**
+   * Remove a person from the list of antiviral takers in amortized O(1), keeping the
+   * order of the others
+   */
+  void remove_av_taker(Person* person);
+
   bool load_completed;
 
   void mother_gives_birth(int day, Person* mother);
@@ -292,11 +342,47 @@ private:
 
   void parse_lines_from_stream(std::istream &stream, bool is_group_quarters_pop);
 
+  /**
+   * Parse one line of a population file, appending the person (if any) to pidv.
+   * A header line sets is_2010_ver1_format.
+   * @return true if the line described a person
+   */
+  bool parse_person_line(char* line, bool is_group_quarters_pop, bool &is_2010_ver1_format,
+			 std::vector<Person_Init_Data> &pidv);
+
+  /**
+   * Parse the newline separated lines in buffer.  Does not modify the Population,
+   * so several buffers may be parsed in parallel.
+   * @return the number of person lines
+   */
+  int parse_lines_from_buffer(char* buffer, size_t size, bool is_group_quarters_pop,
+			      bool is_2010_ver1_format, std::vector<Person_Init_Data> &pidv);
+
+  /**
+   * Add the parsed persons to the population, in order
+   */
+  void add_persons(std::vector<Person_Init_Data> &pidv);
+
+  /**
+   * Read a population file compressed with fbz, uncompressing blocks in parallel
+   */
+  void parse_block_compressed_file(const Block_Compressed_File &file, bool is_group_quarters_pop);
+
   Person_Init_Data get_person_init_data(char* line,
 					bool is_group_quarters_population,
 					bool is_2010_ver1_format);
 
 
+  // adapts a functor taking Person* to bloque::parallel_apply
+  template<typename Functor>
+  struct Person_Visitor {
+    Functor &f;
+    explicit Person_Visitor(Functor &_f) : f(_f) { }
+    void operator()(Person &person) {
+      this->f(&person);
+    }
+  };
+
   bloque<Person, fred::Pop_Masks> blq;   // all Persons in the population
   vector<Person*> death_list;		  // list of agents to die today
   int pop_size;
@@ -307,6 +393,7 @@ private:
   static char pop_outfile[FRED_STRING_SIZE];
   static char output_population_date_match[FRED_STRING_SIZE];
   static int output_population;
+  static int output_population_compressed;
   static bool is_initialized;
   static int next_id;
 
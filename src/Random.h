@@ -87,6 +87,9 @@ public:
   void sample_range_without_replacement(int N, int s, int* result) {
     thread_rng[fred::omp_get_thread_num()].sample_range_without_replacement(N, s, result);
   }
+  RNG& get_rng() {
+    return thread_rng[fred::omp_get_thread_num()];
+  }
 
 private:
   RNG * thread_rng;
@@ -130,6 +133,9 @@ public:
   static void sample_range_without_replacement(int N, int s, int *result) { 
     Random_Number_Generator.sample_range_without_replacement(N,s,result);
   }
+  static RNG& get_thread_rng() {
+    return Random_Number_Generator.get_rng();
+  }
 
 private:
   static Thread_RNG Random_Number_Generator;
@@ -137,13 +143,13 @@ private:
 
 
 template <typename T> 
-void FYShuffle( std::vector <T> &array){
+void FYShuffle( std::vector <T> &array, RNG &rng){
   int m,randIndx;
   T tmp;
-  unsigned int n = array.size();
-  m=n;
+  m = array.size();
   while (m > 0){
-    randIndx = (int)(Random::draw_random()*n);
+    // swap the last unshuffled element with one drawn from the first m
+    randIndx = (int)(rng.random()*m);
     m--;
     tmp = array[m];
     array[m] = array[randIndx];
@@ -151,5 +157,10 @@ void FYShuffle( std::vector <T> &array){
   }
 }
 
+template <typename T> 
+void FYShuffle( std::vector <T> &array){
+  FYShuffle(array, Random::get_thread_rng());
+}
+
 
 #endif // _FRED_RANDOM_H
@@ -13,6 +13,8 @@
 //
 // File: School.cc
 //
+#include <algorithm>
+
 #include "School.h"
 #include "Classroom.h"
 #include "Date.h"
@@ -32,6 +34,7 @@ double School::contacts_per_day;
 double** School::prob_transmission_per_contact;
 int School::school_classroom_size = 0;
 char School::school_closure_policy[80] = "undefined";
+int School::closure_policy = School::CLOSURE_POLICY_NONE;
 int School::school_closure_day = 0;
 int School::min_school_closure_day = 0;
 double School::school_closure_threshold = 0.0;
@@ -59,6 +62,7 @@ bool School::global_closure_schedule_is_enabled = false;
 int School::school_classroom_size_array[GRADES];
 
 std::vector<Time_Step_Map_Closure * > School::school_closure_schedule;
+std::vector<int> School::school_closure_schedule_boundaries;
 
 School::School() : Place() {
   this->set_type(Place::TYPE_SCHOOL);
@@ -77,6 +81,8 @@ School::School() : Place() {
   this->closure_grade_dates_have_been_set = false;
   this->school_closure_dates_checked_today = false;
   this->day_closure_dates_grades_set = -1;
+  this->closure_schedule_is_compiled = false;
+  this->closure_schedule_epoch = -1;
   this->staff_size = 0;
   this->max_grade = -1;
   this->county_index = -1;
@@ -95,11 +101,16 @@ School::School(const char* lab, char _subtype, fred::geo lon, fred::geo lat) : P
     this->orig_students_in_grade[i] = 0;
     this->next_classroom[i] = 0;
     this->classrooms[i].clear();
+    this->close_grade_date[i] = INT_MAX;
+    this->open_grade_date[i] = 0;
+    this->open_capacity_grade[i] = 1.0;
   }
   this->closure_dates_have_been_set = false;
   this->closure_grade_dates_have_been_set = false;
   this->school_closure_dates_checked_today = false;
   this->day_closure_dates_grades_set = -1;
+  this->closure_schedule_is_compiled = false;
+  this->closure_schedule_epoch = -1;
   this->staff_size = 0;
   this->max_grade = -1;
   this->county_index = -1;
@@ -197,6 +208,16 @@ void School::get_parameters() {
 
   // school closure parameters
   Params::get_param_from_string("school_closure_policy", School::school_closure_policy);
+  if(strcmp(School::school_closure_policy, "global") == 0) {
+    School::closure_policy = School::CLOSURE_POLICY_GLOBAL;
+  } else if(strcmp(School::school_closure_policy, "individual") == 0) {
+    School::closure_policy = School::CLOSURE_POLICY_INDIVIDUAL;
+  } else if(strcmp(School::school_closure_policy, "global_schedule") == 0) {
+    School::closure_policy = School::CLOSURE_POLICY_GLOBAL_SCHEDULE;
+  } else {
+    // if school_closure_policy is not recognized, then schools stay open
+    School::closure_policy = School::CLOSURE_POLICY_NONE;
+  }
   Params::get_param_from_string("school_closure_duration", &School::school_closure_duration);
   Params::get_param_from_string("school_closure_delay", &School::school_closure_delay);
   Params::get_param_from_string("school_closure_day", &School::school_closure_day);
@@ -257,6 +278,16 @@ void School::get_parameters() {
       }
       ts_input->close();
     }
+
+    // the active schedule entries change only at these days
+    for(int i = 0; i < static_cast<int>(School::school_closure_schedule.size()); ++i) {
+      School::school_closure_schedule_boundaries.push_back(School::school_closure_schedule[i]->sim_day_start);
+      School::school_closure_schedule_boundaries.push_back(School::school_closure_schedule[i]->sim_day_end + 1);
+    }
+    std::sort(School::school_closure_schedule_boundaries.begin(), School::school_closure_schedule_boundaries.end());
+    School::school_closure_schedule_boundaries.erase(std::unique(School::school_closure_schedule_boundaries.begin(),
+								 School::school_closure_schedule_boundaries.end()),
+						     School::school_closure_schedule_boundaries.end());
   }
   /*
   for(int i = 0; i < School::school_closure_schedule.size(); ++i){
@@ -331,32 +362,15 @@ void School::close_by_grade(int day, int day_to_close, int duration, int min_gra
 
 bool School::is_open(int day) {
   // Ignore closure if school is open by grades
-  int sch_census_tract_index = this->get_census_tract_index();
-  long int sch_census_tract = -1;
-  if(sch_census_tract_index > 0){
-    sch_census_tract = Global::Places.get_census_tract_with_index(sch_census_tract_index);
-  }
-  /*if(sch_census_tract == 11001008526){
-    printf("SCHOOL %s CENSUS TRACT %lu verifying if it is open on day %d\n", this->get_label(),sch_census_tract, day);
-    }*/
   if(this->closure_grade_dates_have_been_set == true){
     bool open_grade = false;
     for(int grade = 0; grade < GRADES; grade++){
       if(day >= this->close_grade_date[grade] && this->open_grade_date[grade] >= day){
 	open_grade = true;
-	/*
-	if(sch_census_tract == 11001008526){
-	  printf("SCHOOL CENSUS TRACT %lu open for grade %d\n", sch_census_tract, grade);
-	  }*/
 	break;
       }
     }
     if(open_grade == true){
-      /*
-      if(sch_census_tract == 11001008526){
-      printf("SCHOOL CENSUS TRACT %lu open at least for one grade on day %d\n", sch_census_tract, day);
-	}*/
-      //printf("SCHOOL CENSUS TRACT %lu open at least for one grade on day %d\n", sch_census_tract, day);
       return true;
     }
   }
@@ -366,22 +380,8 @@ bool School::is_open(int day) {
     this->closure_dates_have_been_set = false;
   }
   if(!open) {
-    /*
-    if(sch_census_tract == 11001008526){
-      printf("SCHOOL CENSUS TRACT %lu closed on day %d\n", sch_census_tract, day);
-      }*/
     FRED_VERBOSE(1, "Place %s is closed on day %d\n", this->get_label(), day);
   }
-  /*
-  else{
-    if(sch_census_tract == 11001008526){
-    printf("SCHOOL CENSUS TRACT %lu open for ALL GRADES on day %d, close date (%d) open date(%d)\n", sch_census_tract, day, this->close_date, this->open_date);
-    }
-  }
-  */
-  if(open){
-    //printf("SCHOOL CENSUS TRACT %lu open for ALL GRADES on day %d, close date (%d) open date(%d)\n", sch_census_tract, day, this->close_date, this->open_date);
-  }
   return open;
 }
 
@@ -396,6 +396,8 @@ bool School::should_be_open_grade(int day, int grade) {
   }
   bool open = (day < this->close_grade_date[grade] || this->open_grade_date[grade] <= day);
   if(!open){
+    // each student attends a partly open grade with probability capacity_open;
+    // the draw is made even for capacity 0 to keep the random stream unchanged
     if(Random::draw_random() < this->open_capacity_grade[grade]) {
       open = true;
     }
@@ -427,88 +429,90 @@ bool School::should_be_open(int day, int disease_id) {
     }
   }
 
-  // global school closure policy in effect
-  if(strcmp(School::school_closure_policy, "global_schedule") == 0) {
-    if(day > this->day_closure_dates_grades_set){
-      apply_global_schedule_school_closure_policy(day, disease_id);
-    }    
-    return is_open(day);
-  }
-  
-  // stick to previously made decision to close
-  if(this->closure_dates_have_been_set) {
+  switch(School::closure_policy) {
+  case School::CLOSURE_POLICY_GLOBAL_SCHEDULE:
+    {
+      // the schedule only needs to be applied again when an entry starts or ends
+      int epoch = School::get_closure_schedule_epoch(day);
+      if(epoch != this->closure_schedule_epoch) {
+	apply_global_schedule_school_closure_policy(day, disease_id);
+	this->closure_schedule_epoch = epoch;
+      }
+      return is_open(day);
+    }
+
+  case School::CLOSURE_POLICY_GLOBAL:
+    // stick to previously made decision to close
+    if(!this->closure_dates_have_been_set) {
+      apply_global_school_closure_policy(day, disease_id);
+    }
     return is_open(day);
-  }
 
-  // global school closure policy in effect
-  if(strcmp(School::school_closure_policy, "global") == 0) {
-    apply_global_school_closure_policy(day, disease_id);
+  case School::CLOSURE_POLICY_INDIVIDUAL:
+    // stick to previously made decision to close
+    if(!this->closure_dates_have_been_set) {
+      apply_individual_school_closure_policy(day, disease_id);
+    }
     return is_open(day);
+
+  default:
+    // stick to previously made decision to close
+    if(this->closure_dates_have_been_set) {
+      return is_open(day);
+    }
+    // if school_closure_policy is not recognized, then open
+    return true;
   }
+}
 
-  // individual school closure policy in effect
-  if(strcmp(School::school_closure_policy, "individual") == 0) {
-    apply_individual_school_closure_policy(day, disease_id);
-    return is_open(day);
-  }  
+int School::get_closure_schedule_epoch(int day) {
+  return std::upper_bound(School::school_closure_schedule_boundaries.begin(),
+			  School::school_closure_schedule_boundaries.end(), day)
+    - School::school_closure_schedule_boundaries.begin();
+}
 
-  // if school_closure_policy is not recognized, then open
-  return true;
+void School::compile_global_schedule_school_closure_policy() {
+  // resolve which schedule entries apply to this school
+  long int sch_census_tract = -1;
+  int sch_census_tract_index = this->get_census_tract_index();
+  if(sch_census_tract_index > 0){
+    sch_census_tract = Global::Places.get_census_tract_with_index(sch_census_tract_index);
+  }
+  this->closure_schedule.clear();
+  for(int i = 0; i < static_cast<int>(School::school_closure_schedule.size()); ++i) {
+    Time_Step_Map_Closure* tmap = School::school_closure_schedule[i];
+    bool applies;
+    if(tmap->income_school > 0) {
+      applies = (tmap->income_school == this->school_income);
+    } else if(tmap->census_tract > 0) {
+      applies = (sch_census_tract_index > 0 && tmap->census_tract == sch_census_tract);
+    } else {
+      applies = true;
+    }
+    if(applies) {
+      this->closure_schedule.push_back(i);
+    }
+  }
+  this->closure_schedule_is_compiled = true;
 }
 
 void School::apply_global_schedule_school_closure_policy(int day, int disease_id) {
-  // Should I move this to place list?
-  // Every day, check is day is within school closure of time step
+  if(!this->closure_schedule_is_compiled) {
+    compile_global_schedule_school_closure_policy();
+  }
+  // Check which of this school's schedule entries include today
   this->closure_grade_dates_have_been_set = false;
-  for(int i = 0; i < School::school_closure_schedule.size(); ++i) {
-    Time_Step_Map_Closure* tmap = School::school_closure_schedule[i];
+  for(int i = 0; i < static_cast<int>(this->closure_schedule.size()); ++i) {
+    Time_Step_Map_Closure* tmap = School::school_closure_schedule[this->closure_schedule[i]];
     if(tmap->sim_day_start <= day && day <= tmap->sim_day_end) {
       // if min grade = 0 and max grade = 20, then close the school, else close some grades only
-      if(tmap->grade_min <= 1 && tmap->grade_max == GRADES && tmap->capacity_open == 0.0 && tmap->income_school < 1 && tmap->census_tract < 1){
-	int sch_census_tract_index = this->get_census_tract_index();
-	long int sch_census_tract = -1;
-	if(sch_census_tract_index > 0){
-	  sch_census_tract = Global::Places.get_census_tract_with_index(sch_census_tract_index);
-	}
-	if(sch_census_tract == 11001008526){
-	  printf("Day: %d School in census_tract %ld closed with tmap %s\n", day, sch_census_tract, tmap->to_string().c_str());
-	}
+      if(School::is_whole_school_closure(tmap)) {
 	close(day,tmap->sim_day_start, tmap->sim_day_end - tmap->sim_day_start);
-      }else if(tmap->grade_min <= 1 && tmap->grade_max == GRADES && tmap->capacity_open == 0.0 && tmap->income_school > 0){
-	if(tmap->income_school == this->school_income){
-	  close(day,tmap->sim_day_start, tmap->sim_day_end - tmap->sim_day_start);
-	}
-      }else if(tmap->grade_min <= 1 && tmap->grade_max == GRADES && tmap->capacity_open == 0.0 && tmap->census_tract > 0){
-	int sch_census_tract_index = this->get_census_tract_index();
-	if(sch_census_tract_index > 0){
-	  long int sch_census_tract = Global::Places.get_census_tract_with_index(sch_census_tract_index);
-	  printf("Applying GLOBAL SCHEDULE with census tract: %lu, checking with school %lu\n", tmap->census_tract, sch_census_tract);
-	  if(tmap->census_tract == sch_census_tract){
-	    close(day,tmap->sim_day_start, tmap->sim_day_end - tmap->sim_day_start);
-	  }
-	}
-      }else{
-	if(tmap->income_school > 0){
-	  if(tmap->income_school == this->school_income){
-	    close_by_grade(day,tmap->sim_day_start, tmap->sim_day_end - tmap->sim_day_start, tmap->grade_min, tmap->grade_max, tmap->capacity_open);
-	  }
-	}else if(tmap->census_tract > 0){
-	  int sch_census_tract_index = this->get_census_tract_index();
-	  if(sch_census_tract_index > 0){
-	    long int sch_census_tract = Global::Places.get_census_tract_with_index(sch_census_tract_index);
-	    if(tmap->census_tract == sch_census_tract){
-	      if(sch_census_tract == 11001008526){
-		printf("Day: %d School in census_tract %ld closed with tmap %s\n", day, sch_census_tract, tmap->to_string().c_str());
-	      }
-	      close_by_grade(day,tmap->sim_day_start, tmap->sim_day_end - tmap->sim_day_start, tmap->grade_min, tmap->grade_max, tmap->capacity_open);
-	    }
-	  }
-	}else{
-	  close_by_grade(day,tmap->sim_day_start, tmap->sim_day_end - tmap->sim_day_start, tmap->grade_min, tmap->grade_max, tmap->capacity_open);
-	}
+      } else {
+	close_by_grade(day,tmap->sim_day_start, tmap->sim_day_end - tmap->sim_day_start, tmap->grade_min, tmap->grade_max, tmap->capacity_open);
       }
       if(Global::Verbose > 0) {
-	printf("GLOBAL SCHEDULE SCHOOL CLOSURE %s\n", tmap->to_string().c_str());
+	printf("GLOBAL SCHEDULE SCHOOL CLOSURE %s %s\n", this->get_label(), tmap->to_string().c_str());
       }
     }
   }
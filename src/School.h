@@ -79,6 +79,7 @@ public:
   void apply_global_school_closure_policy(int day, int disease_id);
   void apply_individual_school_closure_policy(int day, int disease_id);
   void apply_global_schedule_school_closure_policy(int day, int disease_id);
+  void compile_global_schedule_school_closure_policy();
   double get_contacts_per_day(int disease_id);
   int enroll(Person* per);
   void unenroll(int pos);
@@ -213,9 +214,28 @@ public:
   }
 
 private:
+  enum {
+    CLOSURE_POLICY_NONE,
+    CLOSURE_POLICY_GLOBAL,
+    CLOSURE_POLICY_INDIVIDUAL,
+    CLOSURE_POLICY_GLOBAL_SCHEDULE
+  };
+
+  /**
+   * @return the number of schedule boundaries (start days and days after
+   * the end) on or before day; the set of active schedule entries only
+   * changes when this changes
+   */
+  static int get_closure_schedule_epoch(int day);
+
+  static bool is_whole_school_closure(const Time_Step_Map_Closure* tmap) {
+    return tmap->grade_min <= 1 && tmap->grade_max == GRADES && tmap->capacity_open == 0.0;
+  }
+
   static double contacts_per_day;
   static double** prob_transmission_per_contact;
   static char school_closure_policy[];
+  static int closure_policy;
   static int school_closure_day;
   static int min_school_closure_day;
   static double school_closure_threshold;
@@ -243,6 +263,7 @@ private:
   static int pop_income_Q3;
   static int pop_income_Q4;
   static std::vector<Time_Step_Map_Closure * > school_closure_schedule;
+  static std::vector<int> school_closure_schedule_boundaries;
   int students_in_grade[GRADES];
 
   int orig_students_in_grade[GRADES];
@@ -252,6 +273,10 @@ private:
   bool closure_grade_dates_have_been_set;
   bool school_closure_dates_checked_today;
   int day_closure_dates_grades_set;
+  // entries of school_closure_schedule that apply to this school
+  std::vector<int> closure_schedule;
+  bool closure_schedule_is_compiled;
+  int closure_schedule_epoch;
   int max_grade;
   int county_index;
   int income_quartile;
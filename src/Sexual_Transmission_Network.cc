@@ -20,10 +20,15 @@
 #include "Random.h"
 #include "Person.h"
 #include "Population.h"
+#include "Utils.h"
 
 //Private static variables that will be set by parameter lookups
 double Sexual_Transmission_Network::sexual_contacts_per_day = 0.0;
 double Sexual_Transmission_Network::sexual_transmission_per_contact = 0.0;
+double Sexual_Transmission_Network::mean_degree = 2.0;
+char Sexual_Transmission_Network::network_model[FRED_STRING_SIZE];
+char Sexual_Transmission_Network::network_file[FRED_STRING_SIZE];
+char Sexual_Transmission_Network::network_output_file[FRED_STRING_SIZE];
 
 Sexual_Transmission_Network::Sexual_Transmission_Network(const char* lab) : Network(lab) {
   this->set_subtype(Network::SUBTYPE_SEXUAL_PARTNER);
@@ -32,6 +37,10 @@ Sexual_Transmission_Network::Sexual_Transmission_Network(const char* lab) : Netw
 void Sexual_Transmission_Network::get_parameters() {
   Params::get_param_from_string("sexual_partner_contacts", &Sexual_Transmission_Network::sexual_contacts_per_day);
   Params::get_param_from_string("sexual_trans_per_contact", &Sexual_Transmission_Network::sexual_transmission_per_contact);
+  Params::get_param_from_string("sexual_partner_mean_degree", &Sexual_Transmission_Network::mean_degree);
+  Params::get_param_from_string("sexual_partner_network_model", Sexual_Transmission_Network::network_model);
+  Params::get_param_from_string("sexual_partner_network_file", Sexual_Transmission_Network::network_file);
+  Params::get_param_from_string("sexual_partner_network_output_file", Sexual_Transmission_Network::network_output_file);
 }
 
 void Sexual_Transmission_Network::setup() {
@@ -53,6 +62,34 @@ void Sexual_Transmission_Network::setup() {
   }
 
   // create random sexual partnerships
-  Global::Sexual_Partner_Network->create_random_network(2.0);
+  if(strcmp(Sexual_Transmission_Network::network_file, "none") != 0) {
+    if(!read_edge_file(Sexual_Transmission_Network::network_file)) {
+      Utils::fred_abort("Can't read sexual partner network file %s\n", Sexual_Transmission_Network::network_file);
+    }
+  } else if(strcmp(Sexual_Transmission_Network::network_model, "erdos_renyi") == 0) {
+    int size = get_size();
+    if(size > 1) {
+      create_erdos_renyi_network(Sexual_Transmission_Network::mean_degree / (size - 1));
+    }
+  } else if(strcmp(Sexual_Transmission_Network::network_model, "configuration") == 0) {
+    int degree = static_cast<int>(Sexual_Transmission_Network::mean_degree + 0.5);
+    create_configuration_model_network(std::vector<int>(get_size(), degree));
+  } else if(strcmp(Sexual_Transmission_Network::network_model, "random") == 0) {
+    create_random_network(Sexual_Transmission_Network::mean_degree);
+  } else {
+    Utils::fred_abort("Unknown sexual_partner_network_model %s\n", Sexual_Transmission_Network::network_model);
+  }
+
+  if(strcmp(Sexual_Transmission_Network::network_output_file, "none") != 0) {
+    char filename[FRED_STRING_SIZE];
+    if(snprintf(filename, sizeof(filename), "%s/%s", Global::Simulation_directory,
+		Sexual_Transmission_Network::network_output_file) >= static_cast<int>(sizeof(filename))) {
+      Utils::fred_abort("Sexual partner network file name is too long: %s/%s\n", Global::Simulation_directory,
+			Sexual_Transmission_Network::network_output_file);
+    }
+    if(!write_edge_file(filename)) {
+      Utils::fred_abort("Can't write sexual partner network file %s\n", filename);
+    }
+  }
 }
 
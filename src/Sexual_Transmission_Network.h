@@ -39,6 +39,10 @@ public:
 private:
   static double sexual_contacts_per_day;
   static double sexual_transmission_per_contact;
+  static double mean_degree;
+  static char network_model[FRED_STRING_SIZE];
+  static char network_file[FRED_STRING_SIZE];
+  static char network_output_file[FRED_STRING_SIZE];
 
 };
 
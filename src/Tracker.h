@@ -19,6 +19,7 @@
 
 #include <stdlib.h>
 #include <map>
+#include <unordered_map>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -126,6 +127,9 @@ public:
     }
 #pragma omp critical
     { 
+      // with unique = false the first position of a repeated index is kept,
+      // which is what the linear search used to find
+      this->index_positions.insert(std::make_pair(index, (int) this->indices.size()));
       this->indices.push_back(index);
       vector<string> aTypes = _get_allowed_typenames();
       for(int i = 0; i < aTypes.size(); ++i) {
@@ -539,6 +543,7 @@ private:
   string title;
   string index_name;
   vector<T> indices;
+  unordered_map<T, int> index_positions;
   map<string, vector<int> > values_map_int;
   map<string, vector<string> > values_map_string;
   map<string, vector<double> > values_map_double;
@@ -606,12 +611,9 @@ private:
   }
   
   int _index_pos(T index) {
-    typename vector<T>::iterator iter_index;
-    
-    //return index;
-    iter_index = find(this->indices.begin(), this->indices.end(), index);
-    if(iter_index != this->indices.end()) {
-      return distance(this->indices.begin(), iter_index);
+    typename unordered_map<T, int>::const_iterator iter_index = this->index_positions.find(index);
+    if(iter_index != this->index_positions.end()) {
+      return iter_index->second;
     } else {
       return -1;
     }
@@ -16,9 +16,18 @@
 
 #include "Utils.h"
 #include "Global.h"
+#include "Event_Log.h"
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 
 using namespace std;
 using namespace std::chrono;
@@ -118,38 +127,56 @@ void Utils::fred_open_output_files(){
   sprintf(ErrorFilename, "%s/err%d.txt", directory, run);
 
   sprintf(filename, "%s/out%d.txt", directory, run);
-  Global::Outfp = fopen(filename, "w");
+  Global::Outfp = fred_open_async_output_file(filename);
   if(Global::Outfp == NULL) {
     Utils::fred_abort("Can't open %s\n", filename);
   }
   Global::Tracefp = NULL;
   if (strcmp(Global::Tracefilebase, "none") != 0) {
     sprintf(filename, "%s/trace%d.txt", directory, run);
-    Global::Tracefp = fopen(filename, "w");
+    Global::Tracefp = fred_open_async_output_file(filename);
     if(Global::Tracefp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
   }
   Global::Infectionfp = NULL;
+  Global::Infection_log = NULL;
   if(Global::Track_infection_events > 0) {
-    sprintf(filename, "%s/infections%d.txt", directory, run);
-    Global::Infectionfp = fopen(filename, "w");
-    if(Global::Infectionfp == NULL) {
-      Utils::fred_abort("Can't open %s\n", filename);
+    if(Global::Binary_event_log) {
+      sprintf(filename, "%s/infections%d.bin", directory, run);
+      Global::Infection_log = new Event_Log;
+      if(Global::Infection_log->open(filename, Event_Log::INFECTION_EVENTS, Global::Track_infection_events) == false) {
+        Utils::fred_abort("Can't open %s\n", filename);
+      }
+    } else {
+      sprintf(filename, "%s/infections%d.txt", directory, run);
+      Global::Infectionfp = fred_open_async_output_file(filename);
+      if(Global::Infectionfp == NULL) {
+        Utils::fred_abort("Can't open %s\n", filename);
+      }
     }
   }
   Global::InfectionCFfp = NULL;
+  Global::InfectionCF_log = NULL;
   if(Global::Track_fatality_events == true) {
-    sprintf(filename, "%s/infectionsCF%d.txt", directory, run);
-    Global::InfectionCFfp = fopen(filename, "w");
-    if(Global::InfectionCFfp == NULL) {
-      Utils::fred_abort("Can't open %s\n", filename);
+    if(Global::Binary_event_log) {
+      sprintf(filename, "%s/infectionsCF%d.bin", directory, run);
+      Global::InfectionCF_log = new Event_Log;
+      if(Global::InfectionCF_log->open(filename, Event_Log::FATALITY_EVENTS, Global::Track_infection_events) == false) {
+        Utils::fred_abort("Can't open %s\n", filename);
+      }
+    } else {
+      sprintf(filename, "%s/infectionsCF%d.txt", directory, run);
+      Global::InfectionCFfp = fred_open_async_output_file(filename);
+      if(Global::InfectionCFfp == NULL) {
+        Utils::fred_abort("Can't open %s\n", filename);
+      }
     }
   }
   Global::VaccineTracefp = NULL;
   if(strcmp(Global::VaccineTracefilebase, "none") != 0) {
     sprintf(filename, "%s/vacctr%d.txt", directory, run);
-    Global::VaccineTracefp = fopen(filename, "w");
+    Global::VaccineTracefp = fred_open_async_output_file(filename);
     if(Global::VaccineTracefp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
@@ -157,7 +184,7 @@ void Utils::fred_open_output_files(){
   Global::Birthfp = NULL;
   if(Global::Enable_Population_Dynamics) {
     sprintf(filename, "%s/births%d.txt", directory, run);
-    Global::Birthfp = fopen(filename, "w");
+    Global::Birthfp = fred_open_async_output_file(filename);
     if(Global::Birthfp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
@@ -165,7 +192,7 @@ void Utils::fred_open_output_files(){
   Global::Deathfp = NULL;
   if(Global::Enable_Population_Dynamics) {
     sprintf(filename, "%s/deaths%d.txt", directory, run);
-    Global::Deathfp = fopen(filename, "w");
+    Global::Deathfp = fred_open_async_output_file(filename);
     if(Global::Deathfp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
@@ -173,7 +200,7 @@ void Utils::fred_open_output_files(){
   Global::Immunityfp = NULL;
   if(strcmp(Global::Immunityfilebase, "none") != 0) {
     sprintf(filename, "%s/immunity%d.txt", directory, run);
-    Global::Immunityfp = fopen(filename, "w");
+    Global::Immunityfp = fred_open_async_output_file(filename);
     if(Global::Immunityfp == NULL) {
       Utils::fred_abort("Help! Can't open %s\n", filename);
     }
@@ -182,7 +209,7 @@ void Utils::fred_open_output_files(){
   Global::Householdfp = NULL;
   if(Global::Print_Household_Locations) {
     sprintf(filename, "%s/households.txt", directory);
-    Global::Householdfp = fopen(filename, "w");
+    Global::Householdfp = fred_open_async_output_file(filename);
     if(Global::Householdfp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
@@ -191,7 +218,7 @@ void Utils::fred_open_output_files(){
   Global::Tractfp = NULL;
   if(Global::Report_Epidemic_Data_By_Census_Tract) {
     sprintf(filename,"%s/tracts%d.txt",directory,run);
-    Global::Tractfp = fopen(filename,"w");
+    Global::Tractfp = fred_open_async_output_file(filename);
     if(Global::Tractfp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
@@ -200,7 +227,7 @@ void Utils::fred_open_output_files(){
   Global::IncomeCatfp = NULL;
   if(Global::Report_Mean_Household_Stats_Per_Income_Category) {
     sprintf(filename,"%s/income_category%d.txt",directory,run);
-    Global::IncomeCatfp = fopen(filename,"w");
+    Global::IncomeCatfp = fred_open_async_output_file(filename);
     if(Global::IncomeCatfp == NULL) {
       Utils::fred_abort("Can't open %s\n", filename);
     }
@@ -235,6 +262,16 @@ void Utils::fred_end(void){
   if(Global::InfectionCFfp != NULL) {
     fclose(Global::InfectionCFfp);
   }
+  if(Global::Infection_log != NULL) {
+    Global::Infection_log->close();
+    delete Global::Infection_log;
+    Global::Infection_log = NULL;
+  }
+  if(Global::InfectionCF_log != NULL) {
+    Global::InfectionCF_log->close();
+    delete Global::InfectionCF_log;
+    Global::InfectionCF_log = NULL;
+  }
   if(Global::VaccineTracefp != NULL) {
     fclose(Global::VaccineTracefp);
   }
@@ -256,6 +293,16 @@ void Utils::fred_end(void){
   if(Global::IncomeCatfp != NULL) {
     fclose(Global::IncomeCatfp);
   }
+  if(Global::Birthfp != NULL) {
+    fclose(Global::Birthfp);
+    Global::Birthfp = NULL;
+  }
+  if(Global::Deathfp != NULL) {
+    fclose(Global::Deathfp);
+    Global::Deathfp = NULL;
+  }
+  // wait for the background output thread to write everything
+  fred_finish_async_output();
 }
 
 
@@ -402,6 +449,156 @@ FILE* Utils::fred_open_file(char* filename) {
   return fp;
 }
 
+// Background output.  Streams opened with fred_open_async_output_file hand
+// their (already formatted) stdio buffers to a queue instead of writing
+// them; a single background thread writes, flushes and closes the files.
+// The queue is bounded so that a slow disk eventually slows the simulation
+// rather than exhausting memory.
+
+class Async_Output_Queue {
+public:
+  Async_Output_Queue() {
+    this->queued_bytes = 0;
+    this->started = false;
+    this->done = false;
+    this->finished = false;
+  }
+
+  ~Async_Output_Queue() {
+    finish();
+  }
+
+  void push(FILE* fp, const char* data, size_t size, bool close_file) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if(this->finished) {
+      // after shutdown (e.g. streams flushed at exit), write directly
+      lock.unlock();
+      write_item(fp, data, size, close_file);
+      return;
+    }
+    if(this->started == false) {
+      this->writer = std::thread(&Async_Output_Queue::write_loop, this);
+      this->started = true;
+    }
+    while(this->queued_bytes > max_queued_bytes) {
+      this->space_available.wait(lock);
+    }
+    this->items.push_back(Item());
+    Item &item = this->items.back();
+    item.fp = fp;
+    item.data.assign(data, size);
+    item.close_file = close_file;
+    this->queued_bytes += size;
+    this->work_available.notify_one();
+  }
+
+  void finish() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if(this->finished) {
+        return;
+      }
+      this->done = true;
+      this->work_available.notify_one();
+    }
+    if(this->started) {
+      this->writer.join();
+    }
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->finished = true;
+  }
+
+private:
+  struct Item {
+    FILE* fp;
+    std::string data;
+    bool close_file;
+  };
+
+  static const size_t max_queued_bytes = 1ul << 26;
+
+  static void write_item(FILE* fp, const char* data, size_t size, bool close_file) {
+    if(size > 0 && fwrite(data, sizeof(char), size, fp) != size) {
+      fprintf(stderr, "FRED WARNING: background output write failed\n");
+    }
+    if(close_file) {
+      fclose(fp);
+    } else {
+      fflush(fp);
+    }
+  }
+
+  void write_loop() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while(true) {
+      while(this->items.empty() && !this->done) {
+        this->work_available.wait(lock);
+      }
+      if(this->items.empty()) {
+        break;
+      }
+      Item item;
+      item.fp = this->items.front().fp;
+      item.close_file = this->items.front().close_file;
+      item.data.swap(this->items.front().data);
+      this->items.pop_front();
+      lock.unlock();
+      write_item(item.fp, item.data.data(), item.data.size(), item.close_file);
+      lock.lock();
+      this->queued_bytes -= item.data.size();
+      this->space_available.notify_all();
+    }
+  }
+
+  std::deque<Item> items;
+  size_t queued_bytes;
+  bool started;
+  bool done;
+  bool finished;
+  std::mutex mutex;
+  std::condition_variable work_available;
+  std::condition_variable space_available;
+  std::thread writer;
+};
+
+static Async_Output_Queue Async_output;
+
+#ifdef __GLIBC__
+static ssize_t async_output_write(void* cookie, const char* buf, size_t size) {
+  Async_output.push(static_cast<FILE*>(cookie), buf, size, false);
+  return size;
+}
+
+static int async_output_close(void* cookie) {
+  Async_output.push(static_cast<FILE*>(cookie), NULL, 0, true);
+  return 0;
+}
+#endif
+
+FILE* Utils::fred_open_async_output_file(const char* filename) {
+  FILE* fp = fopen(filename, "w");
+  if(fp == NULL) {
+    return NULL;
+  }
+#ifdef __GLIBC__
+  cookie_io_functions_t io_functions = { NULL, async_output_write, NULL, async_output_close };
+  FILE* async_fp = fopencookie(fp, "w", io_functions);
+  if(async_fp == NULL) {
+    return fp;
+  }
+  // large buffers mean fewer, larger items for the background thread
+  setvbuf(async_fp, NULL, _IOFBF, 1 << 18);
+  return async_fp;
+#else
+  // no stream hooks on this platform; write synchronously
+  return fp;
+#endif
+}
+
+void Utils::fred_finish_async_output() {
+  Async_output.finish();
+}
+
 void Utils::get_fred_file_name(char* filename) {
   string str;
   str.assign(filename);
@@ -417,6 +614,79 @@ void Utils::get_fred_file_name(char* filename) {
   }
 }
 
+Utils::Mapped_File::Mapped_File() {
+  this->fd = -1;
+  this->data = NULL;
+  this->size = 0;
+}
+
+Utils::Mapped_File::~Mapped_File() {
+  close();
+}
+
+bool Utils::Mapped_File::open(char* filename) {
+  close();
+  get_fred_file_name(filename);
+  printf("fred_open_file: mapping file %s for reading\n", filename);
+  this->fd = ::open(filename, O_RDONLY);
+  if(this->fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if(fstat(this->fd, &file_stat) != 0) {
+    close();
+    return false;
+  }
+  this->size = file_stat.st_size;
+  if(this->size == 0) {
+    return true;
+  }
+  void* map = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+  if(map == MAP_FAILED) {
+    close();
+    return false;
+  }
+  madvise(map, this->size, MADV_SEQUENTIAL);
+  this->data = static_cast<char*>(map);
+  return true;
+}
+
+void Utils::Mapped_File::close() {
+  if(this->data != NULL) {
+    munmap(this->data, this->size);
+    this->data = NULL;
+  }
+  if(this->fd >= 0) {
+    ::close(this->fd);
+    this->fd = -1;
+  }
+  this->size = 0;
+}
+
+void Utils::Mapped_File::split_into_line_chunks(int n, std::vector<const char*> &bounds) const {
+  bounds.clear();
+  const char* begin = this->data;
+  const char* end = this->data + this->size;
+  bounds.push_back(begin);
+  if(n < 1) {
+    n = 1;
+  }
+  size_t chunk_size = this->size / n;
+  for(int i = 1; i < n && chunk_size > 0; ++i) {
+    const char* p = begin + i * chunk_size;
+    if(p <= bounds.back()) {
+      continue;
+    }
+    // advance to the start of the next line
+    p = static_cast<const char*>(memchr(p - 1, '\n', end - p + 1));
+    if(p == NULL || p + 1 >= end) {
+      break;
+    }
+    bounds.push_back(p + 1);
+  }
+  bounds.push_back(end);
+}
+
 #include <sys/resource.h>
 /*
   #define   RUSAGE_SELF     0
@@ -153,6 +153,20 @@ namespace Utils {
   void fred_log(const char* format, ...);
   void fred_report(const char* format, ...);
   FILE *fred_open_file(char* filename);
+
+  /**
+   * Open a file for writing through the background output thread.  The stream
+   * is used like any other, but writes, fflush and fclose return without
+   * waiting for the disk.
+   * @param filename the file to create
+   * @return the stream, or NULL if the file can not be created
+   */
+  FILE* fred_open_async_output_file(const char* filename);
+
+  /**
+   * Wait until everything written to background output files is on disk
+   */
+  void fred_finish_async_output();
   void get_fred_file_name(char* filename);
   void fred_print_resource_usage(int day);
   void replace_csv_missing_data(char* out_str, char* in_str, const char* replacement);
@@ -221,6 +235,47 @@ namespace Utils {
   };
 
 
+  /**
+   * A read-only memory mapping of an input file.  The contents can be split
+   * into chunks of whole lines so that large files can be parsed in parallel.
+   */
+  class Mapped_File {
+  public:
+    Mapped_File();
+    ~Mapped_File();
+
+    /**
+     * Map the named file into memory
+     * @param filename the file name (may start with $FRED_HOME)
+     * @return true if the file was mapped
+     */
+    bool open(char* filename);
+    void close();
+
+    const char* get_data() const {
+      return this->data;
+    }
+
+    size_t get_size() const {
+      return this->size;
+    }
+
+    /**
+     * Split the mapped file into at most n chunks that each start at the
+     * beginning of a line.  Chunk i spans [bounds[i], bounds[i+1]).
+     * @param n the desired number of chunks
+     * @param bounds the chunk boundaries (number of chunks + 1 entries)
+     */
+    void split_into_line_chunks(int n, std::vector<const char*> &bounds) const;
+
+  private:
+    int fd;
+    char* data;
+    size_t size;
+    Mapped_File(const Mapped_File &);
+    void operator=(const Mapped_File &);
+  };
+
   Tokens &split_by_delim(const std::string &str,
 			 const char delim, Tokens & tokens,
 			 bool collapse_consecutive_delims = true);
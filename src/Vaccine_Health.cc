@@ -15,6 +15,7 @@
 //
 #include <stdio.h>
 #include <assert.h>
+#include <limits.h>
 #include <iostream>
 #include "Random.h"
 #include "Vaccine_Health.h"
@@ -28,11 +29,13 @@
 #include "Global.h"
 
 Vaccine_Health::Vaccine_Health(int _vaccination_day, Vaccine* _vaccine, double _age, 
-			       Person * _person, Vaccine_Manager* _vaccine_manager){
+			       Person * person, Vaccine_Manager* vaccine_manager, int _record){
   
   vaccine = _vaccine;
   vaccination_day = _vaccination_day;
-  person = _person;
+  next = NULL;
+  assert(0 <= _record && _record <= UCHAR_MAX);
+  record = _record;
   
   double efficacy = vaccine->get_dose(0)->get_efficacy(_age);
   double efficacy_symp = vaccine->get_dose(0)->get_efficacy_symp(_age);
@@ -58,7 +61,6 @@ Vaccine_Health::Vaccine_Health(int _vaccination_day, Vaccine* _vaccine, double _
   // vaccine_booster_efficacy_hospitalization_age_groups[%1$d] = 1 100;  
   // vaccine_booster_efficacy_hospitalization_values[%1$d] = 1 %10$.4f;
   
-  vaccine_manager = _vaccine_manager;
   vaccination_immunity_loss_day = -1;
   vaccination_hosp_immunity_loss_day = -1;
   vaccination_effective_day = -1;
@@ -98,12 +100,24 @@ We are gonna get rid of if statements so that everyone can be protected against
   days_to_next_dose = -1;
   next_dose_mix_match = -1;
   if(Global::Debug > 1) {
-    cout << "Agent: " << person->get_id() << " took dose " << current_dose << " on day "<< vaccination_day << "\n";
+    cout << "Agent: " << person->get_id() << " took dose " << (int)current_dose << " on day "<< vaccination_day << "\n";
   }
   if(vaccine->get_number_doses() > 1){
     days_to_next_dose = vaccination_day + vaccine->get_dose(0)->get_days_between_doses();
     next_dose_mix_match = vaccine->get_dose(0)->get_next_dose_mix_match();
   }
+
+  if(vaccination_effective_day != -1) {
+    draw_cross_protection();
+  }
+  add_event(vaccination_effective_day, vaccination_day, Vaccine_event::IMMUNITY_START, person, vaccine_manager);
+  add_event(vaccination_effective_symp_day, vaccination_day, Vaccine_event::SYMPTOMS_IMMUNITY_START, person, vaccine_manager);
+  add_event(vaccination_effective_hosp_day, vaccination_day, Vaccine_event::HOSPITALIZATION_IMMUNITY_START, person, vaccine_manager);
+  add_event(vaccination_immunity_loss_day, vaccination_day + 1, Vaccine_event::IMMUNITY_END, person, vaccine_manager);
+  add_event(vaccination_hosp_immunity_loss_day, vaccination_day + 1, Vaccine_event::HOSPITALIZATION_IMMUNITY_END, person, vaccine_manager);
+  if(vaccine->get_number_doses() > 1){
+    add_event(days_to_next_dose, vaccination_day, Vaccine_event::NEXT_DOSE, person, vaccine_manager);
+  }
   /*
   printf("Vaccine: %d Efficacy %.2f -> %d, Efficacy Symptoms %.2f -> %d, Efficacy Hosp %.2f -> %d\n",
 	 vaccine->get_ID(), efficacy, vaccination_effective_day, efficacy_symp, vaccination_effective_symp_day, efficacy_hosp, vaccination_effective_hosp_day);
@@ -115,192 +129,200 @@ void Vaccine_Health::print() const {
   cout << "\nVaccine_Status";
 }
 
-void Vaccine_Health::printTrace() const {
+void Vaccine_Health::printTrace(Person* person) const {
   fprintf(Global::VaccineTracefp," vaccday %5d age %5.1f iseff %2d iseffsymp %2d ifeffhosp %2d effday %5d currentdose %3d",vaccination_day,
 	  person->get_real_age(),is_effective(), is_effective_symptoms(), is_effective_hospitalization(), this->get_vaccination_any_effective_day(), current_dose);
   fflush(Global::VaccineTracefp);
 }
 
-void Vaccine_Health::update(int day, double age){
-  // First check for immunity
+void Vaccine_Health::draw_cross_protection() {
+  this->cross_protection.reset();
+  if(Global::Enable_Disease_Cross_Protection == false) {
+    return;
+  }
+  for(int dis_id = 1; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id) {
+    if(Random::draw_random() < vaccine->get_disease_specific_efficacy(dis_id)) {
+      this->cross_protection.set(dis_id);
+    }
+  }
+}
+
+void Vaccine_Health::add_event(int event_day, int earliest_day, int event, Person* person, Vaccine_Manager* vaccine_manager) {
+  if(event_day >= earliest_day) {
+    vaccine_manager->add_vaccine_event(event_day, event, person, record);
+  }
+}
+
+void Vaccine_Health::become_immune(int day, Person* person) {
   // CHECK ON VACCINE DIFFERENTIAL EFFICACY AGAINST DISEASE IDS
-  if (is_effective()) {
-    if (day == vaccination_effective_day) {
-      for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
-	if(Global::Enable_Disease_Cross_Protection == false && dis_id > 0){
-	  break;
-	}
-	Disease* disease = Global::Diseases.get_disease(dis_id);
-	if (person->is_infected(disease->get_id())==false) {
-	  if(Global::Enable_Disease_Cross_Protection == true && dis_id > 0){
-	    if(Random::draw_random() <  vaccine->get_disease_specific_efficacy(dis_id)) {
-	      person->become_immune(disease);
-	    }
-	  }else{
-	    person->become_immune(disease);
-	  }
-	  effective = true;
-	  if(Global::Verbose > 0) {
-	    cout << "Agent " << person->get_id() 
-		 << " has become immune from dose "<< current_dose 
-		 << " on day " << day << "\n";
-	  }
-	}
-	else {
-	  if(Global::Verbose > 0) {
-	    cout << "Agent " << person->get_id() 
-		 << " was already infected so did not become immune from dose "<< current_dose 
-		 << " on day " << day << "\n";
-	  }
-	}
-      }
+  if(!is_effective() || day != vaccination_effective_day) {
+    return;
+  }
+  for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
+    if(Global::Enable_Disease_Cross_Protection == false && dis_id > 0){
+      break;
     }
-    if (day == vaccination_immunity_loss_day) {      
+    Disease* disease = Global::Diseases.get_disease(dis_id);
+    if (person->is_infected(disease->get_id())==false) {
+      if(dis_id == 0 || this->cross_protection.test(dis_id)) {
+	person->become_immune(disease);
+      }
+      effective = true;
       if(Global::Verbose > 0) {
 	cout << "Agent " << person->get_id() 
-	     << " became immune on day "<< vaccination_effective_day
-	     << " and lost immunity on day " << day << " duration " <<  "\n";
+	     << " has become immune from dose "<< (int)current_dose 
+	     << " on day " << day << "\n";
       }
-      /*
-	If a person is currently infected, don't clear vaccine immunity, natural imunity would take care of it. 
-       */
-      bool current_infected = false;
-      for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
-	if(person->is_infected(dis_id) == true){
-	  current_infected = true;
-	}
-      }      
-      if(current_infected == false){
-	if(Global::Enable_Disease_Cross_Protection == true && Global::Diseases.get_number_of_diseases() > 1){
-	  for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
-	    person->become_susceptible_by_vaccine_waning(dis_id);
-	  }
-	}else{
-	  int disease_id = 0;
-	  person->become_susceptible_by_vaccine_waning(disease_id);
-	}
+    }
+    else {
+      if(Global::Verbose > 0) {
+	cout << "Agent " << person->get_id() 
+	     << " was already infected so did not become immune from dose "<< (int)current_dose 
+	     << " on day " << day << "\n";
       }
-      effective = false;
     }
   }
-  
-  // Next check on symptoms
-  if (is_effective_symptoms()) {
-    if (day == vaccination_effective_symp_day) {
-      for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
-	if(Global::Enable_Disease_Cross_Protection == false && dis_id > 0){
-	  break;
-	}
-      // Include cross protection here instead of in Health.cc
-	Disease* disease = Global::Diseases.get_disease(dis_id);
-	if (person->is_infected(disease->get_id())==false) {
-	  // Make person become immune to symptoms
-	  if(Random::draw_random() <  vaccine->get_disease_specific_efficacy_symp(dis_id)) {
-	    person->become_immune_to_symptoms(disease);
-	  }else{
-	    person->become_immune_to_symptoms(disease);
-	  }
-	  
-	  effective_symptoms = true;
-	
-	  if(Global::Verbose > 0) {
-	    cout << "Agent " << person->get_id() 
-		 << " has become immune to symptoms from dose "<< current_dose 
-		 << " on day " << day << "\n";
-	  }
-	}
-	else {
-	  if(Global::Verbose > 0) {
-	    cout << "Agent " << person->get_id() 
-		 << " was already infected so did not become immune to symptoms from dose "<< current_dose 
-		 << " on day " << day << "\n";
-	  }
-	}
-      }
+}
+
+void Vaccine_Health::become_immune_to_symptoms(int day, Person* person) {
+  if(!is_effective_symptoms() || day != vaccination_effective_symp_day) {
+    return;
+  }
+  for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
+    if(Global::Enable_Disease_Cross_Protection == false && dis_id > 0){
+      break;
     }
-    if (day == vaccination_immunity_loss_day) {
+    Disease* disease = Global::Diseases.get_disease(dis_id);
+    if (person->is_infected(disease->get_id())==false) {
+      person->become_immune_to_symptoms(disease);
+      effective_symptoms = true;
       if(Global::Verbose > 0) {
 	cout << "Agent " << person->get_id() 
-	     << " became immune on day "<< vaccination_effective_symp_day
-	     << " and lost immunity on day " << day << "\n";
+	     << " has become immune to symptoms from dose "<< (int)current_dose 
+	     << " on day " << day << "\n";
       }
-      /*
-	This looks weird considering there are more than one disease_id
-      */
-      if(Global::Enable_Disease_Cross_Protection == true && Global::Diseases.get_number_of_diseases() > 1){
-	for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
-	  // TODO: Become susceptible to symptoms due to vaccine waning
-	  person->become_susceptible_to_symptoms_by_vaccine_waning(dis_id);
-	}
-      }else{
-	int disease_id = 0;
-	// TODO: Become susceptible to symptoms due to vaccine waning
-	person->become_susceptible_to_symptoms_by_vaccine_waning(disease_id);
+    }
+    else {
+      if(Global::Verbose > 0) {
+	cout << "Agent " << person->get_id() 
+	     << " was already infected so did not become immune to symptoms from dose "<< (int)current_dose 
+	     << " on day " << day << "\n";
       }
-      effective_symptoms = false;
     }
   }
+}
 
-  // Next check on severe disease
-  if (is_effective_hospitalization()) {
-    if (day == vaccination_effective_hosp_day) {
-      for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
-	if(Global::Enable_Disease_Cross_Protection == false && dis_id > 0){
-	  break;
-	}
-      // Include cross protection here instead of in Health.cc
-	Disease* disease = Global::Diseases.get_disease(dis_id);
-	if (person->is_infected(disease->get_id())==false) {
-	  // Make person become immune to symptoms
-	  if(Random::draw_random() <  vaccine->get_disease_specific_efficacy_hosp(dis_id)) {
-	    person->become_immune_to_hospitalization(disease);
-	  }else{
-	    person->become_immune_to_hospitalization(disease);
-	  }
-	
-	  effective_hospitalization = true;
-	
-	  if(Global::Verbose > 0) {
-	    cout << "Agent " << person->get_id() 
-		 << " has become immune to hospitalization from dose "<< current_dose 
-		 << " on day " << day << "\n";
-	  }
-	}
-	else {
-	  if(Global::Verbose > 0) {
-	    cout << "Agent " << person->get_id() 
-		 << " was already infected so did not become immune to hospitalization from dose "<< current_dose 
-		 << " on day " << day << "\n";
-	  }
-	}
+void Vaccine_Health::become_immune_to_hospitalization(int day, Person* person) {
+  if(!is_effective_hospitalization() || day != vaccination_effective_hosp_day) {
+    return;
+  }
+  for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
+    if(Global::Enable_Disease_Cross_Protection == false && dis_id > 0){
+      break;
+    }
+    Disease* disease = Global::Diseases.get_disease(dis_id);
+    if (person->is_infected(disease->get_id())==false) {
+      person->become_immune_to_hospitalization(disease);
+      effective_hospitalization = true;
+      if(Global::Verbose > 0) {
+	cout << "Agent " << person->get_id() 
+	     << " has become immune to hospitalization from dose "<< (int)current_dose 
+	     << " on day " << day << "\n";
       }
     }
-    if (day == vaccination_hosp_immunity_loss_day) {
+    else {
       if(Global::Verbose > 0) {
 	cout << "Agent " << person->get_id() 
-	     << " became immune on day "<< vaccination_effective_hosp_day
-	     << " and lost immunity on day " << day << "\n";
+	     << " was already infected so did not become immune to hospitalization from dose "<< (int)current_dose 
+	     << " on day " << day << "\n";
       }
-      /*
-	This looks weird considering there are more than one disease_id
-      */
-      if(Global::Enable_Disease_Cross_Protection == true && Global::Diseases.get_number_of_diseases() > 1){
+    }
+  }
+}
+
+void Vaccine_Health::lose_immunity(int day, Person* person) {
+  if(day != vaccination_immunity_loss_day) {
+    return;
+  }
+  bool cross_protection_waning = Global::Enable_Disease_Cross_Protection == true && Global::Diseases.get_number_of_diseases() > 1;
+  if (is_effective()) {
+    if(Global::Verbose > 0) {
+      cout << "Agent " << person->get_id() 
+	   << " became immune on day "<< vaccination_effective_day
+	   << " and lost immunity on day " << day << " duration " <<  "\n";
+    }
+    /*
+      If a person is currently infected, don't clear vaccine immunity, natural imunity would take care of it. 
+    */
+    bool current_infected = false;
+    for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
+      if(person->is_infected(dis_id) == true){
+	current_infected = true;
+	break;
+      }
+    }      
+    if(current_infected == false){
+      if(cross_protection_waning){
 	for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
-	  person->become_susceptible_to_hospitalization_by_vaccine_waning(dis_id);
+	  person->become_susceptible_by_vaccine_waning(dis_id);
 	}
       }else{
 	int disease_id = 0;
-	person->become_susceptible_to_hospitalization_by_vaccine_waning(disease_id);
+	person->become_susceptible_by_vaccine_waning(disease_id);
       }
-      effective_hospitalization = false;
     }
+    effective = false;
   }
-  
-  
-  // Next check on dose
+
+  if (is_effective_symptoms()) {
+    if(Global::Verbose > 0) {
+      cout << "Agent " << person->get_id() 
+	   << " became immune on day "<< vaccination_effective_symp_day
+	   << " and lost immunity on day " << day << "\n";
+    }
+    /*
+      This looks weird considering there are more than one disease_id
+    */
+    if(cross_protection_waning){
+      for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
+	// TODO: Become susceptible to symptoms due to vaccine waning
+	person->become_susceptible_to_symptoms_by_vaccine_waning(dis_id);
+      }
+    }else{
+      int disease_id = 0;
+      // TODO: Become susceptible to symptoms due to vaccine waning
+      person->become_susceptible_to_symptoms_by_vaccine_waning(disease_id);
+    }
+    effective_symptoms = false;
+  }
+}
+
+void Vaccine_Health::lose_immunity_to_hospitalization(int day, Person* person) {
+  if(!is_effective_hospitalization() || day != vaccination_hosp_immunity_loss_day) {
+    return;
+  }
+  if(Global::Verbose > 0) {
+    cout << "Agent " << person->get_id() 
+	 << " became immune on day "<< vaccination_effective_hosp_day
+	 << " and lost immunity on day " << day << "\n";
+  }
+  /*
+    This looks weird considering there are more than one disease_id
+  */
+  if(Global::Enable_Disease_Cross_Protection == true && Global::Diseases.get_number_of_diseases() > 1){
+    for(int dis_id = 0; dis_id < Global::Diseases.get_number_of_diseases(); ++dis_id){
+      person->become_susceptible_to_hospitalization_by_vaccine_waning(dis_id);
+    }
+  }else{
+    int disease_id = 0;
+    person->become_susceptible_to_hospitalization_by_vaccine_waning(disease_id);
+  }
+  effective_hospitalization = false;
+}
+
+void Vaccine_Health::advance_dose(int day, Person* person, Vaccine_Manager* vaccine_manager) {
   // Even immunized people get another dose
   // If they are to get another dose, then put them on the queue based on dose priority
- 
   if (current_dose < vaccine->get_number_doses()-1) {   // Are we done with the dosage?
     // Get the dosage policy from the manager
     if(day >= days_to_next_dose){
@@ -311,7 +333,7 @@ void Vaccine_Health::update(int day, double age){
       if(Global::Debug < 1){
 	cout << "Agent " << person->get_id()
 	     << " being put in to the queue with priority " << vaccine_dose_priority
-	     << " for dose " << current_dose 
+	     << " for dose " << (int)current_dose 
 	     << " on day " << day << "\n";
       }
       switch(vaccine_dose_priority){
@@ -336,12 +358,17 @@ void Vaccine_Health::update(int day, double age){
 }
 
 
-void Vaccine_Health::update_for_next_dose(int day, double age){
+void Vaccine_Health::update_for_next_dose(int day, double age, Person* person, Vaccine_Manager* vaccine_manager){
   /*
 TODO: It seems like new doses only updae if not effective. 
 In reality, Not just efficacy can be boosted by a new dose but maybe the duration of immunity.
  */
   vaccination_day = day;
+  int previous_effective_day = vaccination_effective_day;
+  int previous_effective_symp_day = vaccination_effective_symp_day;
+  int previous_effective_hosp_day = vaccination_effective_hosp_day;
+  int previous_immunity_loss_day = vaccination_immunity_loss_day;
+  int previous_hosp_immunity_loss_day = vaccination_hosp_immunity_loss_day;
   if(!is_effective()){
     double efficacy = vaccine->get_dose(current_dose)->get_efficacy(age);
     double efficacy_symp = vaccine->get_dose(current_dose)->get_efficacy_symp(age);
@@ -373,4 +400,26 @@ In reality, Not just efficacy can be boosted by a new dose but maybe the duratio
 	   vaccine->get_ID(), efficacy, vaccination_effective_day, efficacy_symp, vaccination_effective_symp_day, efficacy_hosp, vaccination_effective_hosp_day);
     */
   }
+
+  // schedule the milestones this dose set
+  if(vaccination_effective_day != previous_effective_day) {
+    draw_cross_protection();
+    add_event(vaccination_effective_day, day, Vaccine_event::IMMUNITY_START, person, vaccine_manager);
+  }
+  if(vaccination_effective_symp_day != previous_effective_symp_day) {
+    add_event(vaccination_effective_symp_day, day, Vaccine_event::SYMPTOMS_IMMUNITY_START, person, vaccine_manager);
+  }
+  if(vaccination_effective_hosp_day != previous_effective_hosp_day) {
+    add_event(vaccination_effective_hosp_day, day, Vaccine_event::HOSPITALIZATION_IMMUNITY_START, person, vaccine_manager);
+  }
+  if(vaccination_immunity_loss_day != previous_immunity_loss_day) {
+    add_event(vaccination_immunity_loss_day, day + 1, Vaccine_event::IMMUNITY_END, person, vaccine_manager);
+  }
+  if(vaccination_hosp_immunity_loss_day != previous_hosp_immunity_loss_day) {
+    add_event(vaccination_hosp_immunity_loss_day, day + 1, Vaccine_event::HOSPITALIZATION_IMMUNITY_END, person, vaccine_manager);
+  }
+  if(current_dose < vaccine->get_number_doses() - 1) {
+    // a dose taken late still moves on to the next one
+    add_event(days_to_next_dose > day ? days_to_next_dose : day, day, Vaccine_event::NEXT_DOSE, person, vaccine_manager);
+  }
 }
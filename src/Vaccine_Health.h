@@ -35,7 +35,7 @@ public:
   //Creation Operations
   Vaccine_Health();
   Vaccine_Health(int _vaccination_day, Vaccine* _vaccine, double _age, 
-		 Person * _person, Vaccine_Manager* _vaccine_manager);
+		 Person * person, Vaccine_Manager* vaccine_manager, int _record);
   
   // Access Members
   int get_vaccination_day()              const { return vaccination_day; }
@@ -61,7 +61,6 @@ public:
   int get_current_dose()                 const { return current_dose; }
   int get_days_to_next_dose()            const { return days_to_next_dose; }
   int get_next_dose_mix_match()            const { return next_dose_mix_match; }
-  Vaccine_Manager* get_vaccine_manager() const { return vaccine_manager; }
   // Modifiers
   void set_vaccination_day(int day) { 
     if(vaccination_day ==-1){
@@ -73,29 +72,54 @@ public:
     }
   }
   bool isEffective() { return effective; }
+
+  /**
+   * The next vaccine taken by the same person, if any (see Health::take_vaccine)
+   */
+  Vaccine_Health* get_next() const { return next; }
+  void set_next(Vaccine_Health* _next) { next = _next; }
   
   //Utility Functions
   void print() const;
-  void printTrace() const;
-  void update(int day, double age);
-  void update_for_next_dose(int day, double age);
+  void printTrace(Person* person) const;
+  void update_for_next_dose(int day, double age, Person* person, Vaccine_Manager* vaccine_manager);
+
+  /**
+   * Milestone transitions, each run by its own Vaccine_event (see
+   * Vaccine_Manager::add_vaccine_event).  A transition does nothing unless
+   * day is still the milestone day, so events left over from a milestone
+   * that a later dose moved are ignored.
+   */
+  void become_immune(int day, Person* person);
+  void become_immune_to_symptoms(int day, Person* person);
+  void become_immune_to_hospitalization(int day, Person* person);
+  void lose_immunity(int day, Person* person);
+  void lose_immunity_to_hospitalization(int day, Person* person);
+  void advance_dose(int day, Person* person, Vaccine_Manager* vaccine_manager);
   
 private:
+  void draw_cross_protection();
+  void add_event(int event_day, int earliest_day, int event, Person* person, Vaccine_Manager* vaccine_manager);
+
+  // A record is kept for every vaccinated person, so it holds no pointers
+  // back to the person or the manager; they are passed in instead.
+
   int vaccination_day;              // On which day did you get the vaccine
   int vaccination_effective_day;    // On which day is the vaccine effective
   int vaccination_effective_symp_day;    // On which day is the vaccine effective
   int vaccination_effective_hosp_day;    // On which day is the vaccine effective
   int vaccination_immunity_loss_day;  // On which day does the vaccine lose effectiveness
   int vaccination_hosp_immunity_loss_day;  // On which day does the vaccine lose effectiveness against hospitalization
-  Vaccine* vaccine;                 // Which vaccine did you take
-  int current_dose;                 // Current Dose that the agent is on
   int days_to_next_dose;            // How long between doses
-  int next_dose_mix_match;          // Does it accept other vaccines (with same efficacy of primary vax)
-  Person * person;                  // The person object this belongs to.
-  Vaccine_Manager* vaccine_manager; // Which manager did the vaccine come from?
-  bool effective;
-  bool effective_symptoms;
-  bool effective_hospitalization;
+  Vaccine* vaccine;                 // Which vaccine did you take
+  Vaccine_Health* next;             // Next vaccine taken by the same person
+  unsigned char current_dose;       // Current Dose that the agent is on
+  unsigned char record;             // Position in the person's list of vaccinations
+  signed char next_dose_mix_match;  // Does it accept other vaccines (with same efficacy of primary vax)
+  unsigned char effective : 1;
+  unsigned char effective_symptoms : 1;
+  unsigned char effective_hospitalization : 1;
+  fred::disease_bitset cross_protection;  // diseases (after the first) this vaccine protects against, drawn when it becomes effective
 };
 
 #endif
@@ -29,7 +29,6 @@
 #include "Timestep_Map.h"
 #include "Utils.h"
 #include "Tracker.h"
-#include "Events.h"
 
 #include <algorithm>
 
@@ -57,9 +56,6 @@ Vaccine_Manager::Vaccine_Manager() {
   this->vaccine_dose_priority = -1;
   this->refresh_vaccine_queues_daily = false;
   this->vaccinate_symptomatics = false;
-  this->vaccine_next_dose_event_queue = new Events();
-  this->vaccine_immunity_start_event_queue = new Events();
-  this->vaccine_immunity_end_event_queue = new Events();
   printf("Finished creating vaccine manager ()\n");
 }
 
@@ -68,11 +64,10 @@ Vaccine_Manager::Vaccine_Manager(Population *_pop) :
   printf("Vaccine manager entered\n");
   this->priority_queue_vector.clear();
   this->pop = _pop;
-
-  this->vaccine_next_dose_event_queue = new Events();
-  this->vaccine_immunity_start_event_queue = new Events();
-  this->vaccine_immunity_end_event_queue = new Events();
-  printf("Created queues in vaccine manager (pop)\n");
+  // only set when vaccination phases are enabled
+  this->current_priority_included = -1;
+  this->enable_vaccine_priority_discrete_refill = false;
+  this->enable_onday_vaccine_priority_discrete = false;
 
   this->vaccine_package = new Vaccines();
   int num_vaccs = 0;
@@ -426,10 +421,19 @@ void Vaccine_Manager::fill_queues() {
     }    
     printf("Priority queue has %lu size, regular queue %lu size\n", this->priority_queue.size(), this->queue.size());    
   }else{
+    // the priority of each person is decided in parallel, and the queues
+    // are filled in index order.  These decisions make no random draws;
+    // the phase decisions above do, and depend on current_policy, so they
+    // are made one person at a time.
+    Policy* policy = this->policies[current_policy];
+    std::vector<char> has_priority(pop->get_index_size(), false);
+    this->pop->parallel_for([&](Person* person) {
+	has_priority[person->get_pop_index()] = policy->choose_first_positive(person, 0, 0);
+      });
     for(int ip = 0; ip < pop->get_index_size(); ip++) {
       Person * current_person = this->pop->get_person_by_index(ip);
       if (current_person != NULL) {
-	if(this->policies[current_policy]->choose_first_positive(current_person, 0, 0) == true) {
+	if(has_priority[ip]) {
 	  priority_queue.push_back(current_person);
 	} else {
 	  if(this->vaccine_priority_only == false)
@@ -576,10 +580,10 @@ void Vaccine_Manager::update(int day) {
     int total_vax = vaccinate(day);
 
     printf("After vaccinating %d people, process immunity events\n", total_vax);
-    //Update events for: gaining immunity and loss of imminuty
-    this->process_vaccine_next_dose_events(day);
-    this->process_vaccine_immunity_start_events(day);
-    this->process_vaccine_immunity_end_events(day);
+    //Update events for: next doses, gaining immunity and loss of imminuty
+    for(int event = 0; event < Vaccine_event::NUM_EVENTS; ++event) {
+      this->process_vaccine_events(day, event);
+    }
   }
 }
 
@@ -596,52 +600,38 @@ void Vaccine_Manager::print() {
   this->vaccine_package->print();
 }
 
-void Vaccine_Manager::process_vaccine_immunity_start_events(int day){
-  int size = this->vaccine_immunity_start_event_queue->get_size(day);
-  printf("VAX_IMM_START_EVENT_QUEUE day %d size %d\n", day, size);
-  if(size <= 0){
+void Vaccine_Manager::add_vaccine_event(int day, int event, Person* person, int record) {
+  if(day < 0) {
     return;
   }
-  for(int i = 0; i < size; ++i) {
-    Person* person =  this->vaccine_immunity_start_event_queue->get_event(day, i);
-
-    FRED_VERBOSE(1,"vaccine_immunity_start_event day %d person %d\n",
-		 day, person->get_id());
-    person->update_vaccine_interventions(day);
+  std::vector< std::vector<Vaccine_Event_Entry> > &event_queue = this->vaccine_event_queue[event];
+  if(day >= static_cast<int>(event_queue.size())) {
+    event_queue.resize(day + 1);
   }
-  this->vaccine_immunity_start_event_queue->clear_events(day);
+  Vaccine_Event_Entry entry;
+  entry.person = person;
+  entry.record = record;
+  event_queue[day].push_back(entry);
 }
 
-void Vaccine_Manager::process_vaccine_next_dose_events(int day){
-  int size = this->vaccine_next_dose_event_queue->get_size(day);
-  printf("VAX_NEXT_DOSE_EVENT_QUEUE day %d size %d\n", day, size);
+void Vaccine_Manager::process_vaccine_events(int day, int event){
+  static const char* event_name[Vaccine_event::NUM_EVENTS] = {
+    "VAX_NEXT_DOSE", "VAX_IMM_START", "VAX_SYMP_IMM_START", "VAX_HOSP_IMM_START", "VAX_IMM_END", "VAX_HOSP_IMM_END"
+  };
+  std::vector< std::vector<Vaccine_Event_Entry> > &event_queue = this->vaccine_event_queue[event];
+  int size = (day < static_cast<int>(event_queue.size()) ? static_cast<int>(event_queue[day].size()) : 0);
+  printf("%s_EVENT_QUEUE day %d size %d\n", event_name[event], day, size);
   if(size <= 0){
     return;
   }
   for(int i = 0; i < size; ++i) {
-    Person* person =  this->vaccine_next_dose_event_queue->get_event(day, i);
+    Vaccine_Event_Entry entry = event_queue[day][i];
 
-    FRED_VERBOSE(1,"vaccine_next_dose_event day %d person %d\n",
-		 day, person->get_id());
-    person->update_vaccine_interventions(day);
+    FRED_VERBOSE(1,"%s event day %d person %d\n",
+		 event_name[event], day, entry.person->get_id());
+    entry.person->process_vaccine_event(day, event, entry.record, this);
   }
-  this->vaccine_next_dose_event_queue->clear_events(day);
-}
-
-void Vaccine_Manager::process_vaccine_immunity_end_events(int day){
-  int size = this->vaccine_immunity_end_event_queue->get_size(day);
-  printf("VAX_IMM_END_EVENT_QUEUE day %d size %d\n", day, size);
-  if(size <= 0){
-    return;
-  }
-  for(int i = 0; i < size; ++i) {
-    Person* person =  this->vaccine_immunity_end_event_queue->get_event(day, i);
-
-    FRED_VERBOSE(1,"vaccine_immunity_end_event day %d person %d\n",
-		 day, person->get_id());
-    person->update_vaccine_interventions(day);
-  }
-  this->vaccine_immunity_end_event_queue->clear_events(day);
+  std::vector<Vaccine_Event_Entry>().swap(event_queue[day]);
 }
 
 int Vaccine_Manager::vaccinate(int day) {
@@ -816,62 +806,10 @@ int Vaccine_Manager::vaccinate(int day) {
         total_vaccines_avail--;
         current_person->take_vaccine(vacc, day, this);
         int curr_dose = current_person->get_current_vaccine_dose(0);
-        if(curr_dose < vacc->get_number_doses() - 1 && curr_dose > -1){
-          int days_next_dose = current_person->get_days_to_next_dose(0);	  
-          if(days_next_dose > 0){
-            this->vaccine_next_dose_event_queue->add_event(days_next_dose, current_person);
-          }
-        }else{
+        if(curr_dose >= vacc->get_number_doses() - 1 || curr_dose < 0){
           number_total_doses++;
         }
         ip = this->next_dose_queue.erase(ip);  // remove a vaccinated person
-        // ADD VACCINE EVENTS TO QUEUE TO PROCESS LATER
-	      int is_vax_effective = current_person->is_vaccine_effective_any();
-	      if(is_vax_effective != -1){
-	      int eff_day = current_person->get_vaccination_effective_day();
-        //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-        if(eff_day > -1){
-          this->vaccine_immunity_start_event_queue->add_event(eff_day, current_person);
-          
-        // Cancel immunity end events first
-        int eff_end_day = current_person->get_vaccination_immunity_loss_day();
-        if(eff_end_day > day){
-          // Add new immunity start/end events
-          // Make sure when ending immunity to check that the day is the immunity end day
-          this->vaccine_immunity_end_event_queue->add_event(eff_end_day, current_person);
-        }
-      }
-      int eff_symp_day = current_person->get_vaccination_symp_effective_day();
-      //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-      if(eff_symp_day > -1){
-        if(eff_day == -1){
-          this->vaccine_immunity_start_event_queue->add_event(eff_symp_day, current_person);
-        }
-	    
-	    // Cancel immunity end events first
-	    int eff_symp_end_day = current_person->get_vaccination_immunity_loss_day();
-	    if(eff_symp_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_symp_end_day, current_person);
-	    }
-	  }
-	  int eff_hosp_day = current_person->get_vaccination_hosp_effective_day();
-	  //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-	  if(eff_hosp_day > -1){
-	    if(eff_symp_day == -1){
-	      this->vaccine_immunity_start_event_queue->add_event(eff_hosp_day, current_person);
-	    }
-	    
-	    // Cancel immunity end events first
-	    int eff_hosp_end_day = current_person->get_vaccination_hosp_immunity_loss_day();
-	    if(eff_hosp_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_hosp_end_day, current_person);
-	    }
-	  }
-	}
 
       } else {
         reject_count++;
@@ -1035,62 +973,10 @@ if(accept_vaccine == true) {
     if(curr_dose == 3){
       vax_3_age_count[age_n]++;
     }
-    if(curr_dose < vacc->get_number_doses() - 1 && curr_dose > -1){
-      int days_next_dose = current_person->get_days_to_next_dose(0);	  
-    if(days_next_dose > 0){
-      this->vaccine_next_dose_event_queue->add_event(days_next_dose, current_person);
-    }
-    }else{
+    if(curr_dose >= vacc->get_number_doses() - 1 || curr_dose < 0){
       number_total_doses++;
     }
         ip = this->priority_queue.erase(ip);  // remove a vaccinated person
-	// ADD VACCINE EVENTS TO QUEUE TO PROCESS LATER
-	int is_vax_effective = current_person->is_vaccine_effective_any();
-	if(is_vax_effective != -1){
-	  int eff_day = current_person->get_vaccination_effective_day();
-	  //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-	  if(eff_day > -1){
-	    this->vaccine_immunity_start_event_queue->add_event(eff_day, current_person);
-	    
-	    // Cancel immunity end events first
-	    int eff_end_day = current_person->get_vaccination_immunity_loss_day();
-	    if(eff_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_end_day, current_person);
-	    }
-	  }
-	  int eff_symp_day = current_person->get_vaccination_symp_effective_day();
-	  //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-	  if(eff_symp_day > -1){
-	    if(eff_day == -1){
-	      this->vaccine_immunity_start_event_queue->add_event(eff_symp_day, current_person);
-	    }
-	    
-	    // Cancel immunity end events first
-	    int eff_symp_end_day = current_person->get_vaccination_immunity_loss_day();
-	    if(eff_symp_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_symp_end_day, current_person);
-	    }
-	  }
-	  int eff_hosp_day = current_person->get_vaccination_hosp_effective_day();
-	  //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-	  if(eff_hosp_day > -1){
-	    if(eff_symp_day == -1){
-	      this->vaccine_immunity_start_event_queue->add_event(eff_hosp_day, current_person);
-	    }
-	    
-	    // Cancel immunity end events first
-	    int eff_hosp_end_day = current_person->get_vaccination_hosp_immunity_loss_day();
-	    if(eff_hosp_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_hosp_end_day, current_person);
-	    }
-	  }
-	}
       } else {
         reject_count++;
 	// TODO: HBM FIX THIS!
@@ -1256,62 +1142,11 @@ if(accept_vaccine == true) {
         if (curr_dose == 3) {
           vax_3_age_count[age_n]++;
         }
-        if(curr_dose < vacc->get_number_doses() - 1 && curr_dose > -1){	  
-          int days_next_dose = current_person->get_days_to_next_dose(0);
-          if(days_next_dose > 0){
-            this->vaccine_next_dose_event_queue->add_event(days_next_dose, current_person);
-          }
-        }else{
+        if(curr_dose >= vacc->get_number_doses() - 1 || curr_dose < 0){
           number_total_doses++;
         }
         ip = this->queue.erase(ip);  // remove a vaccinated person
 
-	int is_vax_effective = current_person->is_vaccine_effective_any();
-	if(is_vax_effective != -1){
-	  	  int eff_day = current_person->get_vaccination_effective_day();
-	  //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-	  if(eff_day > -1){
-	    this->vaccine_immunity_start_event_queue->add_event(eff_day, current_person);
-	    
-	    // Cancel immunity end events first
-	    int eff_end_day = current_person->get_vaccination_immunity_loss_day();
-	    if(eff_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_end_day, current_person);
-	    }
-	  }
-	  int eff_symp_day = current_person->get_vaccination_symp_effective_day();
-	  //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-	  if(eff_symp_day > -1){
-	    if(eff_day == -1){
-	      this->vaccine_immunity_start_event_queue->add_event(eff_symp_day, current_person);
-	    }
-	    
-	    // Cancel immunity end events first
-	    int eff_symp_end_day = current_person->get_vaccination_immunity_loss_day();
-	    if(eff_symp_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_symp_end_day, current_person);
-	    }
-	  }
-	  int eff_hosp_day = current_person->get_vaccination_hosp_effective_day();
-	  //printf("Day %d Vaccination is effective for person %d on day %d\n", day, current_person->get_id(), eff_day);
-	  if(eff_hosp_day > -1){
-	    if(eff_symp_day == -1){
-	      this->vaccine_immunity_start_event_queue->add_event(eff_hosp_day, current_person);
-	    }
-	    
-	    // Cancel immunity end events first
-	    int eff_hosp_end_day = current_person->get_vaccination_hosp_immunity_loss_day();
-	    if(eff_hosp_end_day > day){
-	      // Add new immunity start/end events
-	      // Make sure when ending immunity to check that the day is the immunity end day
-	      this->vaccine_immunity_end_event_queue->add_event(eff_hosp_end_day, current_person);
-	    }
-	  }
-	}
       } else {
         // printf("vaccine rejected by person %d age %0.1f\n", current_person->get_id(), current_person->get_real_age());
         reject_count++;
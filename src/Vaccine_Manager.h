@@ -34,13 +34,36 @@
 
 using namespace std;
 
+class Person;
+
+/**
+ * Vaccine milestones, each processed from its own event queue in this order
+ */
+namespace Vaccine_event {
+  enum e {
+    NEXT_DOSE,
+    IMMUNITY_START,
+    SYMPTOMS_IMMUNITY_START,
+    HOSPITALIZATION_IMMUNITY_START,
+    IMMUNITY_END,                  // immunity to infection and to symptoms
+    HOSPITALIZATION_IMMUNITY_END,
+    NUM_EVENTS
+  };
+};
+
+/**
+ * A scheduled milestone of one of a person's vaccinations
+ */
+struct Vaccine_Event_Entry {
+  Person* person;
+  int record;     // position of the Vaccine_Health in the person's list
+};
+
 class Manager;
 class Population;
 class Vaccines;
-class Person;
 class Policy;
 class Timestep_Map;
-class Events;
 
 class Vaccine_Manager: public Manager {
   //Vaccine_Manager handles a stock of vaccines
@@ -128,6 +151,15 @@ public:
 
   string get_vaccine_dose_priority_string() const;
   
+  /**
+   * Schedule a milestone of a person's vaccination
+   * @param day the day of the milestone
+   * @param event the Vaccine_event
+   * @param person the vaccinee
+   * @param record the position of the vaccination in the person's list
+   */
+  void add_vaccine_event(int day, int event, Person* person, int record);
+
   // Utility Members
   void update(int day);
   void reset();
@@ -135,12 +167,9 @@ public:
   
 private:
   // events processing
-  void process_vaccine_immunity_start_events(int day);
-  void process_vaccine_next_dose_events(int day);
-  void process_vaccine_immunity_end_events(int day);
-  Events* vaccine_next_dose_event_queue;
-  Events* vaccine_immunity_start_event_queue;  
-  Events* vaccine_immunity_end_event_queue;
+  void process_vaccine_events(int day, int event);
+  // for each event, the entries due on each day
+  std::vector< std::vector<Vaccine_Event_Entry> > vaccine_event_queue[Vaccine_event::NUM_EVENTS];
   
   Vaccines* vaccine_package;             //Pointer to the vaccines that this manager oversees
   list<Person *> priority_queue;         //Queue for the priority agents
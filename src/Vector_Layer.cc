@@ -411,14 +411,15 @@ void Vector_Layer::setup_vector_control_by_census_tract(){
     census_temp.threshold = 1000.00;
     census_temp.eligible_for_vector_control = false;
     census_temp.exceeded_threshold = false;
-    for(int j = 0;j<census_tracts_with_vector_control.size();j++){
-      if(census_temp.ind == census_tracts_with_vector_control[j]){
-	census_temp.eligible_for_vector_control = true;
-	census_temp.threshold = this->vector_control_threshold;
-      }
-    }
     census_tract_set.push_back(census_temp);
   }
+  for(int j = 0;j<census_tracts_with_vector_control.size();j++){
+    int t = Global::Places.get_index_of_census_tract(census_tracts_with_vector_control[j]);
+    if(t >= 0){
+      census_tract_set[t].eligible_for_vector_control = true;
+      census_tract_set[t].threshold = this->vector_control_threshold;
+    }
+  }
 
   // For each neighborhood that implements vector control, allocate the neighborhoods in the census tract set
 
@@ -14,11 +14,13 @@
 // File: Visualization_Layer.cc
 //
 
+#include <algorithm>
 #include <list>
 #include <string>
 #include <utility>
 using namespace std;
 
+#include "Household.h"
 #include "Params.h"
 #include "Place_List.h"
 #include "Random.h"
@@ -28,13 +30,9 @@ using namespace std;
 #include "Visualization_Patch.h"
 #include "Disease_List.h"
 
-typedef std::map<unsigned long long, unsigned long> census_tract_t;
-census_tract_t census_tract;
-census_tract_t census_tract_pop;
-
-void Visualization_Layer::add_census_tract(unsigned long long tract) {
-  census_tract[tract] = 0;
-  census_tract_pop[tract] = 0;
+static bool census_tract_order(int index1, int index2) {
+  return (unsigned long long)Global::Places.get_census_tract_with_index(index1)
+    < (unsigned long long)Global::Places.get_census_tract_with_index(index2);
 }
 
 Visualization_Layer::Visualization_Layer() {
@@ -46,6 +44,7 @@ Visualization_Layer::Visualization_Layer() {
   Params::get_param_from_string("census_tract_visualization_mode", &this->census_tract_mode);
 
   this->households.clear();
+  this->output_metrics_ready = false;
 
   if(this->gaia_mode) {
     // create visualization grid
@@ -271,263 +270,266 @@ void Visualization_Layer::create_data_directories(char* vis_top_dir) {
 
 
 void Visualization_Layer::print_visualization_data(int day) {
-  if(this->census_tract_mode) {
-    for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
-      char dir[FRED_STRING_SIZE];
-      sprintf(dir, "%s/VIS/run%d", Global::Simulation_directory, Global::Simulation_run_number);
-      print_census_tract_data(dir, disease_id, Global::OUTPUT_I, (char*)"I", day);
-      print_census_tract_data(dir, disease_id, Global::OUTPUT_Is, (char*)"Is", day);
-      print_census_tract_data(dir, disease_id, Global::OUTPUT_C, (char*)"C", day);
-      print_census_tract_data(dir, disease_id, Global::OUTPUT_Cs, (char*)"Cs", day);
-      print_census_tract_data(dir, disease_id, Global::OUTPUT_P, (char*)"P", day);
-      if (Global::Diseases.get_disease(disease_id)->is_case_fatality_enabled()) {
-	print_census_tract_data(dir, disease_id, Global::OUTPUT_CF, (char*)"CF", day);
-	print_census_tract_data(dir, disease_id, Global::OUTPUT_TCF, (char*)"TCF", day);
-      }
-    }
+  if(!this->output_metrics_ready) {
+    setup_output_metrics();
+  }
 
-    if(Global::Enable_HAZEL) {
-      char dir[FRED_STRING_SIZE];
-      print_census_tract_data(dir, 0, Global::OUTPUT_HC_DEFICIT, (char*)"HC_DEFICIT", day);
+  // one pass over the households collects the data for every output file
+  aggregate_household_data(day);
+
+  if(this->census_tract_mode) {
+    char dir[FRED_STRING_SIZE];
+    sprintf(dir, "%s/VIS/run%d", Global::Simulation_directory, Global::Simulation_run_number);
+    for(int metric = 0; metric < static_cast<int>(this->census_tract_metrics.size()); ++metric) {
+      print_census_tract_data(dir, metric, day);
     }
   }
 
   if(this->household_mode) {
-    for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
-      char dir[FRED_STRING_SIZE];
-      sprintf(dir, "%s/VIS/run%d", Global::Simulation_directory, Global::Simulation_run_number);
-      print_household_data(dir, disease_id, day);
-    }
+    char dir[FRED_STRING_SIZE];
+    sprintf(dir, "%s/VIS/run%d", Global::Simulation_directory, Global::Simulation_run_number);
+    print_household_data(dir, day);
   }
 
   if(this->gaia_mode) {
+    char dir[FRED_STRING_SIZE];
+    sprintf(dir, "%s/GAIA/run%d", Global::Simulation_directory, Global::Simulation_run_number);
+    for(int metric = 0; metric < static_cast<int>(this->gaia_metrics.size()); ++metric) {
+      print_output_data(dir, metric, day);
+    }
     for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
-      char dir[FRED_STRING_SIZE];
-      sprintf(dir, "%s/GAIA/run%d", Global::Simulation_directory, Global::Simulation_run_number);
-      print_output_data(dir, disease_id, Global::OUTPUT_I, (char*) "I", day);
-      print_output_data(dir, disease_id, Global::OUTPUT_Is, (char*)"Is", day);
-      print_output_data(dir, disease_id, Global::OUTPUT_C, (char*)"C", day);
-      print_output_data(dir, disease_id, Global::OUTPUT_Cs, (char*)"Cs", day);
-      print_output_data(dir, disease_id, Global::OUTPUT_P, (char*)"P", day);
       print_population_data(dir, disease_id, day);
       if(Global::Enable_Vector_Layer) {
 	      print_vector_data(dir, disease_id, day);
       }
     }
-  }
-}
-
-void Visualization_Layer::print_household_data(char* dir, int disease_id, int day) {
 
-  // household with new cases
-  char filename[FRED_STRING_SIZE];
-  sprintf(filename, "%s/dis%d/C/households-%d.txt", dir, disease_id, day);
-  FILE* fp = fopen(filename, "w");
-  fprintf(fp, "lat long\n");
-  int size = this->households.size();
-  for(int i = 0; i < size; ++i) {
-    Place* house = this->households[i];
-    if(house->get_new_infections(day, disease_id) > 0) {
-      fprintf(fp, "%f %f\n", house->get_latitude(), house->get_longitude());
+    if(Global::Enable_HAZEL) {
+      int size = this->households.size();
+      for(int i = 0; i < size; ++i) {
+        Household* hh = static_cast<Household*>(this->households[i]);
+        hh->reset_healthcare_info();
+      }
     }
   }
-  fclose(fp);
+}
 
-  // household with active infections
-  sprintf(filename, "%s/dis%d/P/households-%d.txt", dir, disease_id, day);
-  fp = fopen(filename, "w");
-  fprintf(fp, "lat long\n");
-  for(int i = 0; i < size; ++i) {
-    Place* house = this->households[i];
-    //  just consider human infectious, not mosquito neither infectious places visited
-    if(house->get_current_infections(day, disease_id) > 0) {
-      fprintf(fp, "%f %f\n", house->get_latitude(), house->get_longitude());
+void Visualization_Layer::setup_output_metrics() {
+  for(int disease_id = 0; disease_id < Global::Diseases.get_number_of_diseases(); ++disease_id) {
+    bool case_fatality = Global::Diseases.get_disease(disease_id)->is_case_fatality_enabled();
+
+    this->census_tract_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_I, "I"));
+    this->census_tract_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_Is, "Is"));
+    this->census_tract_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_C, "C"));
+    this->census_tract_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_Cs, "Cs"));
+    this->census_tract_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_P, "P"));
+    if(case_fatality) {
+      this->census_tract_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_CF, "CF"));
+      this->census_tract_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_TCF, "TCF"));
     }
-  }
-  fclose(fp);
 
-  // household with infectious cases
-  sprintf(filename, "%s/dis%d/I/households-%d.txt", dir, disease_id, day);
-  fp = fopen(filename, "w");
-  fprintf(fp, "lat long\n");
-  for(int i = 0; i < size; ++i) {
-    Place* house = this->households[i];
-    //  just consider human infectious, not mosquito neither infectious places visited
-    if(house->is_human_infectious(disease_id)) {
-      fprintf(fp, "%f %f\n", house->get_latitude(), house->get_longitude());
+    this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_NEW_INFECTIONS, "C"));
+    this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_CURRENT_INFECTIONS, "P"));
+    this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_INFECTIOUS, "I"));
+    this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_RECOVERED, "R"));
+    if(case_fatality) {
+      this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_CURRENT_CASE_FATALITIES, "CF"));
+      this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_TOTAL_CASE_FATALITIES, "TCF"));
+    }
+    if(Global::Enable_HAZEL) {
+      this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_PRIMARY_HC_UNAV, "HH_primary_hc_unav"));
+      this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_ACCEPT_INSR_HC_UNAV, "HH_accept_insr_hc_unav"));
+      this->household_metrics.push_back(Output_Metric(disease_id, HOUSEHOLD_HC_UNAV, "HH_hc_unav"));
     }
+
+    this->gaia_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_I, "I"));
+    this->gaia_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_Is, "Is"));
+    this->gaia_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_C, "C"));
+    this->gaia_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_Cs, "Cs"));
+    this->gaia_metrics.push_back(Output_Metric(disease_id, Global::OUTPUT_P, "P"));
+  }
+  if(Global::Enable_HAZEL) {
+    this->census_tract_metrics.push_back(Output_Metric(0, Global::OUTPUT_HC_DEFICIT, "HC_DEFICIT"));
   }
-  fclose(fp);
 
-  // household with recovered cases
-  sprintf(filename, "%s/dis%d/R/households-%d.txt", dir, disease_id, day);
-  fp = fopen(filename, "w");
-  fprintf(fp, "lat long\n");
+  // census tracts are reported in order of their FIPS code
+  int size = this->households.size();
+  vector<bool> has_households(Global::Places.get_number_of_census_tracts(), false);
   for(int i = 0; i < size; ++i) {
-    Place* house = this->households[i];
-    if(house->is_recovered(disease_id)) {
-      fprintf(fp, "%f %f\n", house->get_latitude(), house->get_longitude());
+    has_households[static_cast<Household*>(this->households[i])->get_census_tract_index()] = true;
+  }
+  this->census_tracts.clear();
+  for(int index = 0; index < static_cast<int>(has_households.size()); ++index) {
+    if(has_households[index]) {
+      this->census_tracts.push_back(index);
     }
   }
-  fclose(fp);
+  std::sort(this->census_tracts.begin(), this->census_tracts.end(), census_tract_order);
 
-  if (Global::Diseases.get_disease(disease_id)->is_case_fatality_enabled()) {
-    // household with current case fatalities
-    sprintf(filename, "%s/dis%d/CF/households-%d.txt", dir, disease_id, day);
-    fp = fopen(filename, "w");
-    fprintf(fp, "lat long\n");
+  // households do not move, so find their patches once
+  if(this->gaia_mode) {
+    this->household_patch.resize(size);
     for(int i = 0; i < size; ++i) {
-      Place* house = this->households[i];
-      if(house->get_current_case_fatalities(day, disease_id) > 0) {
-	fprintf(fp, "%f %f\n", house->get_latitude(), house->get_longitude());
+      int row = get_row(this->households[i]->get_latitude());
+      int col = get_col(this->households[i]->get_longitude());
+      if(row >= 0 && col >= 0 && row < this->rows && col < this->cols) {
+        this->household_patch[i] = row * this->cols + col;
+      } else {
+        this->household_patch[i] = -1;
       }
     }
-    fclose(fp);
+  }
 
-    // households with any case_fatalities
-    sprintf(filename, "%s/dis%d/TCF/households-%d.txt", dir, disease_id, day);
-    fp = fopen(filename, "w");
-    fprintf(fp, "lat long\n");
-    for(int i = 0; i < size; ++i) {
-      Place* house = this->households[i];
-      if(house->get_total_case_fatalities(disease_id) > 0) {
-	fprintf(fp, "%f %f\n", house->get_latitude(), house->get_longitude());
-      }
-    }
-    fclose(fp);
+  this->output_metrics_ready = true;
+}
 
-  }
+void Visualization_Layer::aggregate_household_data(int day) {
+  int census_tract_metric_count = this->census_tract_metrics.size();
+  int household_metric_count = this->household_metrics.size();
+  int gaia_metric_count = this->gaia_metrics.size();
 
-  // household with Healthcare availability deficiency
-  if(Global::Enable_HAZEL) {
+  if(this->census_tract_mode) {
+    int census_tract_count = Global::Places.get_number_of_census_tracts();
+    this->census_tract_counts.assign(census_tract_count * census_tract_metric_count, 0);
+    this->census_tract_popsize.assign(census_tract_count, 0);
+  }
+  if(this->household_mode) {
+    this->household_lines.assign(household_metric_count, std::string());
+  }
+  if(this->gaia_mode) {
+    this->patch_counts.assign(this->rows * this->cols * gaia_metric_count, 0);
+    this->patch_popsize.assign(this->rows * this->cols, 0);
+  }
 
-    //!is_primary_healthcare_available
-    sprintf(filename, "%s/dis%d/HH_primary_hc_unav/households-%d.txt", dir, disease_id, day);
-    fp = fopen(filename, "w");
-    assert(fp != NULL);
-    fprintf(fp, "lat long\n");
-    for(int i = 0; i < size; ++i) {
-      Household* hh = static_cast<Household*>(this->households[i]);
-      if(hh->is_seeking_healthcare() && !hh->is_primary_healthcare_available()) {
-        fprintf(fp, "%f %f\n", hh->get_latitude(), hh->get_longitude());
+  char line[FRED_STRING_SIZE];
+  int size = this->households.size();
+  for(int i = 0; i < size; ++i) {
+    Household* hh = static_cast<Household*>(this->households[i]);
+    int popsize = hh->get_size();
+
+    if(this->census_tract_mode) {
+      int census_tract_index = hh->get_census_tract_index();
+      this->census_tract_popsize[census_tract_index] += popsize;
+      unsigned long* counts = &this->census_tract_counts[census_tract_index * census_tract_metric_count];
+      for(int metric = 0; metric < census_tract_metric_count; ++metric) {
+        const Output_Metric &m = this->census_tract_metrics[metric];
+        counts[metric] += hh->get_visualization_counter(day, m.disease_id, m.output_code);
       }
     }
-    fclose(fp);
 
-    //!is_other_healthcare_location_that_accepts_insurance_available
-    sprintf(filename, "%s/dis%d/HH_accept_insr_hc_unav/households-%d.txt", dir, disease_id, day);
-    fp = fopen(filename, "w");
-    fprintf(fp, "lat long\n");
-    for(int i = 0; i < size; ++i) {
-      Household* hh = static_cast<Household*>(this->households[i]);
-      if(hh->is_seeking_healthcare() && !hh->is_other_healthcare_location_that_accepts_insurance_available()) {
-        fprintf(fp, "%f %f\n", hh->get_latitude(), hh->get_longitude());
+    if(this->household_mode) {
+      line[0] = '\0';
+      for(int metric = 0; metric < household_metric_count; ++metric) {
+        if(household_has_output(hh, day, this->household_metrics[metric])) {
+          if(line[0] == '\0') {
+            sprintf(line, "%f %f\n", hh->get_latitude(), hh->get_longitude());
+          }
+          this->household_lines[metric] += line;
+        }
       }
     }
-    fclose(fp);
 
-    //!is_healthcare_available
-    sprintf(filename, "%s/dis%d/HH_hc_unav/households-%d.txt", dir, disease_id, day);
-    fp = fopen(filename, "w");
-    fprintf(fp, "lat long\n");
-    for(int i = 0; i < size; ++i) {
-      Household* hh = static_cast<Household*>(this->households[i]);
-      if(hh->is_seeking_healthcare() && !hh->is_healthcare_available()) {
-        fprintf(fp, "%f %f\n", hh->get_latitude(), hh->get_longitude());
+    if(this->gaia_mode && this->household_patch[i] >= 0) {
+      int patch = this->household_patch[i];
+      this->patch_popsize[patch] += popsize;
+      int* counts = &this->patch_counts[patch * gaia_metric_count];
+      for(int metric = 0; metric < gaia_metric_count; ++metric) {
+        const Output_Metric &m = this->gaia_metrics[metric];
+        counts[metric] += hh->get_visualization_counter(day, m.disease_id, m.output_code);
       }
     }
-    fclose(fp);
   }
 }
 
-/*
-  void Visualization_Layer::print_household_data(char* dir, int disease_id, int output_code, char* output_str, int day) {
-  char filename[FRED_STRING_SIZE];
-  sprintf(filename, "%s/dis%d/%s/households-%d.txt", dir, disease_id, output_str, day);
-  FILE* fp = fopen(filename, "w");
-  fprintf(fp, "lat long\n");
-  this->infected_households.clear();
-  // get the counts for this output_code
-  Global::Places.get_visualization_data_from_households(disease_id, output_code);
-  // print out the lat long of all infected households
-  int houses = (int)(this->infected_households.size());
-  for(int i = 0; i < houses; ++i) {
-  fred::geo lat = infected_households[i].first;
-  fred::geo lon = infected_households[i].second;
-  fprintf(fp, "%lf %lf\n", lat, lon);
-  }
-  fclose(fp);
-  this->infected_households.clear();
+bool Visualization_Layer::household_has_output(Household* hh, int day, const Output_Metric &metric) {
+  int disease_id = metric.disease_id;
+  switch(metric.output_code) {
+    case HOUSEHOLD_NEW_INFECTIONS:
+      return hh->get_new_infections(day, disease_id) > 0;
+    case HOUSEHOLD_CURRENT_INFECTIONS:
+      //  just consider human infectious, not mosquito neither infectious places visited
+      return hh->get_current_infections(day, disease_id) > 0;
+    case HOUSEHOLD_INFECTIOUS:
+      return hh->is_human_infectious(disease_id);
+    case HOUSEHOLD_RECOVERED:
+      return hh->is_recovered(disease_id);
+    case HOUSEHOLD_CURRENT_CASE_FATALITIES:
+      return hh->get_current_case_fatalities(day, disease_id) > 0;
+    case HOUSEHOLD_TOTAL_CASE_FATALITIES:
+      return hh->get_total_case_fatalities(disease_id) > 0;
+    case HOUSEHOLD_PRIMARY_HC_UNAV:
+      return hh->is_seeking_healthcare() && !hh->is_primary_healthcare_available();
+    case HOUSEHOLD_ACCEPT_INSR_HC_UNAV:
+      return hh->is_seeking_healthcare() && !hh->is_other_healthcare_location_that_accepts_insurance_available();
+    case HOUSEHOLD_HC_UNAV:
+      return hh->is_seeking_healthcare() && !hh->is_healthcare_available();
   }
-*/
+  return false;
+}
 
-void Visualization_Layer::print_output_data(char* dir, int disease_id, int output_code, char* output_str, int day) {
+void Visualization_Layer::print_household_data(char* dir, int day) {
   char filename[FRED_STRING_SIZE];
-  sprintf(filename, "%s/dis%d/%s/day-%d.txt", dir, disease_id, output_str, day);
-  FILE* fp = fopen(filename, "w");
-  // printf("print_output_data to file %s\n", filename);
+  for(int metric = 0; metric < static_cast<int>(this->household_metrics.size()); ++metric) {
+    const Output_Metric &m = this->household_metrics[metric];
+    sprintf(filename, "%s/dis%d/%s/households-%d.txt", dir, m.disease_id, m.output_str, day);
+    FILE* fp = Utils::fred_open_async_output_file(filename);
+    fprintf(fp, "lat long\n");
+    fputs(this->household_lines[metric].c_str(), fp);
+    fclose(fp);
+    std::string().swap(this->household_lines[metric]);
+  }
+}
 
-  // get the counts for this output_code
-  Global::Places.get_visualization_data_from_households(day, disease_id, output_code);
+void Visualization_Layer::print_output_data(char* dir, int metric, int day) {
+  const Output_Metric &m = this->gaia_metrics[metric];
+  char filename[FRED_STRING_SIZE];
+  sprintf(filename, "%s/dis%d/%s/day-%d.txt", dir, m.disease_id, m.output_str, day);
+  FILE* fp = Utils::fred_open_async_output_file(filename);
 
   // print out the non-zero patches
+  int gaia_metric_count = this->gaia_metrics.size();
   for(int i = 0; i < this->rows; ++i) {
     for (int j = 0; j < this->cols; ++j) {
-      Visualization_Patch* patch = (Visualization_Patch*) &(this->grid[i][j]);
-      int count = patch->get_count();
+      int patch = i * this->cols + j;
+      int count = this->patch_counts[patch * gaia_metric_count + metric];
       if(count > 0) {
-	      int popsize = patch->get_popsize();
-	      fprintf(fp, "%d %d %d %d\n", i, j, count, popsize);
+	      fprintf(fp, "%d %d %d %d\n", i, j, count, this->patch_popsize[patch]);
       }
-      // zero out this patch
-      patch->reset_counts();
     }
   }
   fclose(fp);
 }
 
-void Visualization_Layer::print_census_tract_data(char* dir, int disease_id, int output_code, char* output_str, int day) {
+void Visualization_Layer::print_census_tract_data(char* dir, int metric, int day) {
+  const Output_Metric &m = this->census_tract_metrics[metric];
   char filename[FRED_STRING_SIZE];
-  sprintf(filename, "%s/dis%d/%s/census_tracts-%d.txt", dir, disease_id, output_str, day);
+  sprintf(filename, "%s/dis%d/%s/census_tracts-%d.txt", dir, m.disease_id, m.output_str, day);
 
-  // get the counts for this output_code
-  Global::Places.get_census_tract_data_from_households(day, disease_id, output_code);
-
-  FILE* fp = fopen(filename, "w");
+  FILE* fp = Utils::fred_open_async_output_file(filename);
   fprintf(fp, "Census_tract\tCount\tPopsize\n");
-  for(census_tract_t::iterator itr = census_tract.begin(); itr != census_tract.end(); ++itr) {
-    unsigned long long tract = itr->first;
-    fprintf(fp, "%011lld\t%lu\t%lu\n", tract, itr->second, census_tract_pop[tract]);
+  int census_tract_metric_count = this->census_tract_metrics.size();
+  for(int i = 0; i < static_cast<int>(this->census_tracts.size()); ++i) {
+    int census_tract_index = this->census_tracts[i];
+    unsigned long long tract = Global::Places.get_census_tract_with_index(census_tract_index);
+    fprintf(fp, "%011lld\t%lu\t%lu\n", tract,
+	    this->census_tract_counts[census_tract_index * census_tract_metric_count + metric],
+	    this->census_tract_popsize[census_tract_index]);
   }
   fclose(fp);
-
-  // clear census_tract_counts
-  for(census_tract_t::iterator itr = census_tract.begin(); itr != census_tract.end(); ++itr) {
-    itr->second = 0;
-  }
-  for(census_tract_t::iterator itr = census_tract_pop.begin(); itr != census_tract_pop.end(); ++itr) {
-    itr->second = 0;
-  }
 }
 
 void Visualization_Layer::print_population_data(char* dir, int disease_id, int day) {
   char filename[FRED_STRING_SIZE];
   // printf("Printing population size for GAIA\n");
   sprintf(filename,"%s/dis%d/N/day-%d.txt",dir,disease_id,day);
-  FILE* fp = fopen(filename, "w");
+  FILE* fp = Utils::fred_open_async_output_file(filename);
 
-  // get the counts for an arbitrary output code;
-  // we only care about the popsize here.
-  Global::Places.get_visualization_data_from_households(day, disease_id, Global::OUTPUT_C);
   for(int i = 0; i < this->rows; ++i) {
     for(int j = 0; j < this->cols; ++j) {
-      Visualization_Patch* patch = (Visualization_Patch*) &grid[i][j];
-      int popsize = patch->get_popsize();
+      int popsize = this->patch_popsize[i * this->cols + j];
       if(popsize > 0) {
 	      fprintf(fp, "%d %d %d\n", i, j, popsize);
       }
-      // zero out this patch
-      patch->reset_counts();
     }
   }
   fclose(fp);
@@ -537,7 +539,7 @@ void Visualization_Layer::print_vector_data(char* dir, int disease_id, int day)
   char filename[FRED_STRING_SIZE];
   // printf("Printing population size for GAIA\n");
   sprintf(filename,"%s/dis%d/Vec/day-%d.txt",dir,disease_id,day);
-  FILE* fp = fopen(filename, "w");
+  FILE* fp = Utils::fred_open_async_output_file(filename);
 
   Global::Vectors->update_visualization_data(disease_id, day);
   for(int i = 0; i < this->rows; ++i) {
@@ -563,29 +565,6 @@ void Visualization_Layer::initialize_household_data(fred::geo latitude, fred::ge
   */
 }
 
-void Visualization_Layer::update_data(fred::geo latitude, fred::geo longitude, int count, int popsize) {
-  if(this->gaia_mode) {
-    Visualization_Patch* patch = get_patch(latitude, longitude);
-    if(patch != NULL) {
-      patch->update_patch_count(count, popsize);
-    }
-  }
-
-  if(Global::Enable_HAZEL) {
-    int size = this->households.size();
-    for(int i = 0; i < size; ++i) {
-      Household* hh = static_cast<Household*>(this->households[i]);
-      hh->reset_healthcare_info();
-    }
-  }
-  /*
-    if (count > 0) {
-    point p = std::make_pair(latitude, longitude);
-    this->infected_households.push_back(p);
-    }
-  */
-}
-
 void Visualization_Layer::update_data(double x, double y, int count, int popsize) {
   Visualization_Patch* patch = get_patch(x, y);
   if(patch != NULL) {
@@ -593,10 +572,6 @@ void Visualization_Layer::update_data(double x, double y, int count, int popsize
   }
 }
 
-void Visualization_Layer::update_data(unsigned long long tract, int count, int popsize) {
-  census_tract[tract] += count;
-  census_tract_pop[tract] += popsize;
-}
 
 
 
@@ -17,6 +17,7 @@
 #ifndef _FRED_VISUALIZATION_GRID_H
 #define _FRED_VISUALIZATION_GRID_H
 
+#include <string>
 #include <vector>
 
 #include "Abstract_Grid.h"
@@ -26,6 +27,7 @@
 
 typedef std::pair<double, double> point;
 
+class Household;
 class Visualization_Patch;
 
 class Visualization_Layer : public Abstract_Grid {
@@ -38,7 +40,6 @@ public:
   Visualization_Patch* get_patch(double x, double y);
   Visualization_Patch* select_random_patch();
   void quality_control();
-  void add_census_tract(unsigned long long tract);
   void initialize();
   void create_data_directories(char* vis_top_dir);
   void print_visualization_data(int day);
@@ -48,14 +49,11 @@ public:
     this->households.push_back(h);
   }
 
-  void print_household_data(char* dir, int disease_id, int day);
-  // void print_household_data(char* dir, int disease_id, int output_code, char* output_str, int day);
-  void print_output_data(char* dir, int disease_id, int output_code, char* output_str, int day);
-  void print_census_tract_data(char* dir, int disease_id, int output_code, char* output_str, int day);
+  void print_household_data(char* dir, int day);
+  void print_output_data(char* dir, int metric, int day);
+  void print_census_tract_data(char* dir, int metric, int day);
   void initialize_household_data(fred::geo latitude, fred::geo longitude, int count);
-  void update_data(fred::geo latitude, fred::geo longitude, int count, int popsize);
   void update_data(double x, double y, int count, int popsize);
-  void update_data(unsigned long long tract, int count, int popsize);
 
 protected:
   Visualization_Patch** grid;            // Rectangular array of patches
@@ -67,6 +65,51 @@ protected:
   // vector<point> all_households;
   vector<Place*> households;
 
+private:
+
+  /*
+   * One output file per day: the counter (see Place::get_visualization_counter)
+   * or, for household_mode, the HOUSEHOLD_* test that it reports, for one disease
+   */
+  enum {
+    HOUSEHOLD_NEW_INFECTIONS,
+    HOUSEHOLD_CURRENT_INFECTIONS,
+    HOUSEHOLD_INFECTIOUS,
+    HOUSEHOLD_RECOVERED,
+    HOUSEHOLD_CURRENT_CASE_FATALITIES,
+    HOUSEHOLD_TOTAL_CASE_FATALITIES,
+    HOUSEHOLD_PRIMARY_HC_UNAV,
+    HOUSEHOLD_ACCEPT_INSR_HC_UNAV,
+    HOUSEHOLD_HC_UNAV
+  };
+
+  struct Output_Metric {
+    int disease_id;
+    int output_code;
+    const char* output_str;
+    Output_Metric(int _disease_id, int _output_code, const char* _output_str)
+      : disease_id(_disease_id), output_code(_output_code), output_str(_output_str) {
+    }
+  };
+
+  void setup_output_metrics();
+  void aggregate_household_data(int day);
+  bool household_has_output(Household* hh, int day, const Output_Metric &metric);
+
+  bool output_metrics_ready;
+  vector<Output_Metric> census_tract_metrics;
+  vector<Output_Metric> household_metrics;
+  vector<Output_Metric> gaia_metrics;
+
+  // filled by a single pass over the households each day
+  vector<int> census_tracts;                  // census tract indices, sorted by census tract
+  vector<unsigned long> census_tract_counts;  // [census tract index * metrics + metric]
+  vector<unsigned long> census_tract_popsize;
+  vector<int> household_patch;                // row * cols + col, or -1 if off the grid
+  vector<int> patch_counts;                   // [patch * metrics + metric]
+  vector<int> patch_popsize;
+  vector<std::string> household_lines;        // [metric]
+
 };
 
 #endif // _FRED_VISUALIZATION_GRID_H
@@ -0,0 +1,70 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "Block_Compression.h"
+
+
+int main( int argc, char *argv[] ) {
+
+  int compress_flag = 0;
+  int uncompress_flag = 0;
+
+  opterr = 0;
+  extern char * optarg;
+
+  int f;
+
+  char * filename = NULL;
+
+  while ((f = getopt (argc, argv, "c:u:")) != -1) {
+    switch (f) {
+    case 'c':
+      compress_flag = 1;
+      filename = optarg;
+      break;
+    case 'u':
+      uncompress_flag = 1;
+      filename = optarg;
+      break;
+    case '?':
+      std::cerr << "\nfbz, FRED's block compression utility.  Usage:\n\n";
+      std::cerr << "  fbz -c <file> => file will be block compressed and written to stdout\n";
+      std::cerr << "  fbz -u <file> => file assumed to have been compressed with fbz; will be uncompressed to stdout\n\n";
+      break;
+    default:
+      abort();
+    }
+  }
+
+  if ( compress_flag && uncompress_flag ) {
+    std::cerr << "Specify either [-c] or [-u], not both\n\n";
+    exit(1);
+  }
+  else if ( !compress_flag && !uncompress_flag ) {
+    std::cerr << "Specify either [-c] or [-u]\n\n";
+    exit(1);
+  }
+
+  bool ok;
+  if ( compress_flag ) {
+    ok = Block_Compressed_File::compress_file( filename, stdout );
+  }
+  else {
+    ok = Block_Compressed_File::uncompress_file( filename, stdout );
+  }
+  fflush(stdout);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+/*
+  This file is part of the FRED system.
+
+  Copyright (c) 2010-2015, University of Pittsburgh, John Grefenstette,
+  Shawn Brown, Roni Rosenfield, Alona Fyshe, David Galloway, Nathan
+  Stone, Jay DePasse, Anuroop Sriram, and Donald Burke.
+
+  Licensed under the BSD 3-Clause license.  See the file "LICENSE" for
+  more information.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include "Event_Log.h"
+
+
+int main( int argc, char *argv[] ) {
+
+  if ( argc != 2 ) {
+    std::cerr << "\nfred_events, converts FRED's binary event logs to text.  Usage:\n\n";
+    std::cerr << "  fred_events <file> => infections<n>.bin or infectionsCF<n>.bin written to stdout\n";
+    std::cerr << "                        in the format of infections<n>.txt or infectionsCF<n>.txt\n\n";
+    exit(1);
+  }
+
+  if ( !Event_Log::convert_to_text( argv[1], std::cout ) ) {
+    std::cerr << "fred_events: " << argv[1] << " is not a FRED event log\n";
+    exit(1);
+  }
+  std::cout.flush();
+  return 0;
+}